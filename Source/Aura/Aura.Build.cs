@@ -15,7 +15,11 @@ public class Aura : ModuleRules
             "Engine", 
             "InputCore",
             "EnhancedInput", 
-            "GameplayAbilities"  
+            "GameplayAbilities",
+            "DeveloperSettings",
+            "AnimationSharing",
+            "ReplicationGraph",
+            "NetCore"
         });
 
         // 私有模块依赖声明
@@ -25,7 +29,9 @@ public class Aura : ModuleRules
         {
 
             "GameplayTags",       // 游戏标签系统模块：用于管理和查询游戏对象的状态标签
-            "GameplayTasks"       // 游戏任务系统模块：用于创建和管理游戏中的任务、目标系统
+            "GameplayTasks",      // 游戏任务系统模块：用于创建和管理游戏中的任务、目标系统
+            "NavigationSystem",   // 导航系统模块：点击移动时异步寻路
+            "AnimationBudgetAllocator" // 动画预算分配器：按总预算降低敌人动画的更新频率
         });
 
         // Uncomment if you are using Slate UI
@@ -4,6 +4,23 @@
 
 #include "CoreMinimal.h"
 
+/**
+ * Aura模块日志分类
+ * 用法：UE_LOG(LogAura, Log, TEXT("..."));
+ */
+DECLARE_LOG_CATEGORY_EXTERN(LogAura, Log, All);
 
+/**
+ * 敌人高亮的模板值
+ * 其他高亮类别（友方、拾取物、任务目标）的模板值见Interaction/AuraHighlightCategory.h
+ */
 #define CUSTOM_DEPTH_RED 250
 
+/**
+ * 选中目标专用碰撞通道
+ * 在DefaultEngine.ini的[/Script/Engine.CollisionProfile]中注册为"Target"（默认响应为Block）
+ * 场景几何（墙壁、地面）默认阻挡该通道，光标不能穿墙选中敌人
+ * 角色的胶囊体和网格忽略该通道，角色身上只有悬停代理（HoverProxy）阻挡，光标检测和范围选敌都使用它
+ */
+#define ECC_Target ECollisionChannel::ECC_GameTraceChannel1
+
@@ -3,3 +3,16 @@
 
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 
+void UAuraAbilitySystemComponent::ResetRuntimeState()
+{
+    CancelAllAbilities();
+
+    // 先复制句柄列表，移除效果时容器会被修改
+    const TArray<FActiveGameplayEffectHandle> ActiveEffectHandles = ActiveGameplayEffects.GetAllActiveEffectHandles();
+    for (const FActiveGameplayEffectHandle& Handle : ActiveEffectHandles)
+    {
+        RemoveActiveGameplayEffect(Handle);
+    }
+
+    RemoveAllGameplayCues();
+}
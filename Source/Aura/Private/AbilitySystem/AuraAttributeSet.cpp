@@ -25,6 +25,50 @@ UAuraAttributeSet::UAuraAttributeSet()
     InitMaxMana(50.f);
 }
 
+/**
+ * ResetToDefaults 函数
+ * 默认值取自实际类的CDO，子类在构造函数中修改的初始值同样生效
+ */
+void UAuraAttributeSet::ResetToDefaults()
+{
+    const UAuraAttributeSet* Defaults = GetClass()->GetDefaultObject<UAuraAttributeSet>();
+    UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+    if (!ASC)
+    {
+        InitHealth(Defaults->GetHealth());
+        InitMaxHealth(Defaults->GetMaxHealth());
+        InitMana(Defaults->GetMana());
+        InitMaxMana(Defaults->GetMaxMana());
+        return;
+    }
+
+    // 先恢复最大值，再恢复当前值
+    ASC->SetNumericAttributeBase(GetMaxHealthAttribute(), Defaults->GetMaxHealth());
+    ASC->SetNumericAttributeBase(GetHealthAttribute(), Defaults->GetHealth());
+    ASC->SetNumericAttributeBase(GetMaxManaAttribute(), Defaults->GetMaxMana());
+    ASC->SetNumericAttributeBase(GetManaAttribute(), Defaults->GetMana());
+}
+
+FAuraDormantAttributes UAuraAttributeSet::MakeDormantDefaults()
+{
+    const UAuraAttributeSet* Defaults = GetDefault<UAuraAttributeSet>();
+
+    FAuraDormantAttributes Dormant;
+    Dormant.Health = Defaults->GetHealth();
+    Dormant.MaxHealth = Defaults->GetMaxHealth();
+    Dormant.Mana = Defaults->GetMana();
+    Dormant.MaxMana = Defaults->GetMaxMana();
+    return Dormant;
+}
+
+void UAuraAttributeSet::InitFromDormant(const FAuraDormantAttributes& Dormant)
+{
+    InitMaxHealth(Dormant.MaxHealth);
+    InitHealth(Dormant.Health);
+    InitMaxMana(Dormant.MaxMana);
+    InitMana(Dormant.Mana);
+}
+
 /**
  * 获取生命周期复制属性
  * 重写此函数以声明哪些属性需要进行网络复制
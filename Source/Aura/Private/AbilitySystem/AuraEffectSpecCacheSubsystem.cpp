@@ -0,0 +1,22 @@
+// Copyright Amor
+
+
+#include "AbilitySystem/AuraEffectSpecCacheSubsystem.h"
+#include "Actor/AuraEffectActor.h"
+
+#include "Aura/Aura.h"
+
+FGameplayEffectSpecHandle UAuraEffectSpecCacheSubsystem::GetOutgoingSpec(const AAuraEffectActor* EffectActor)
+{
+    if (!EffectActor) return FGameplayEffectSpecHandle();
+
+    UClass* EffectActorClass = EffectActor->GetClass();
+    if (const FGameplayEffectSpecHandle* CachedSpec = CachedSpecs.Find(EffectActorClass))
+    {
+        return *CachedSpec;
+    }
+
+    const FGameplayEffectSpecHandle SpecHandle = EffectActorClass->GetDefaultObject<AAuraEffectActor>()->MakeOutgoingSpec();
+    CachedSpecs.Add(EffectActorClass, SpecHandle);
+    return SpecHandle;
+}
@@ -0,0 +1,16 @@
+// Copyright Amor
+
+
+#include "AbilitySystem/AuraHealthPotionEffect.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+
+UAuraHealthPotionEffect::UAuraHealthPotionEffect()
+{
+    DurationPolicy = EGameplayEffectDurationType::Instant;
+
+    FGameplayModifierInfo HealthModifier;
+    HealthModifier.Attribute = UAuraAttributeSet::GetHealthAttribute();
+    HealthModifier.ModifierOp = EGameplayModOp::Additive;
+    HealthModifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(FScalableFloat(HealAmount));
+    Modifiers.Add(HealthModifier);
+}
@@ -1,11 +1,20 @@
 // Copyright Amor
 
 #include "Actor/AuraEffectActor.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayEffect.h"
 #include "AbilitySystemInterface.h"
-#include "AbilitySystem/AuraAttributeSet.h"
+#include "AbilitySystem/AuraEffectSpecCacheSubsystem.h"
+#include "AbilitySystem/AuraHealthPotionEffect.h"
+#include "Character/AuraEnemy.h"
 #include "Components/SphereComponent.h" 
+#include "Components/StaticMeshComponent.h"
+#include "Game/AuraDeveloperSettings.h"
+#include "Game/AuraPickupPoolSubsystem.h"
+#include "Game/AuraPickupVisualsSubsystem.h"
+#include "Net/UnrealNetwork.h"
 
-#include "Actor/AuraEffectActor.h"
+#include "Aura/Aura.h"
 
 /**
  * AAuraEffectActor 构造函数
@@ -26,6 +35,7 @@ AAuraEffectActor::AAuraEffectActor()
      * "Mesh": 组件名称，在编辑器中标识
      * SetRootComponent: 将此组件设置为Actor的根组件
      * 根组件是所有其他组件的父级，决定了Actor的变换基础
+     * 开启实例化渲染时该组件只作为模板（网格、材质和变换在蓝图中编辑），自己不渲染
      */
     Mesh = CreateDefaultSubobject<UStaticMeshComponent>("Mesh");
     SetRootComponent(Mesh);
@@ -40,6 +50,26 @@ AAuraEffectActor::AAuraEffectActor()
     Sphere = CreateDefaultSubobject<USphereComponent>("Sphere");
     Sphere->SetupAttachment(GetRootComponent());
 
+    /**
+     * 网络复制与休眠
+     * 拾取状态（bPooled）由服务器复制到客户端
+     * 效果Actor在被拾取之前没有任何状态变化，放置在关卡中的实例从一开始就休眠，
+     * 服务器每次网络更新都不需要考虑它们；拾取和重新出现时先刷新休眠，复制一次后重新休眠
+     * 位置也需要复制：刷新点可能把对象池中的效果Actor取出到新的位置
+     */
+    bReplicates = true;
+    SetReplicateMovement(true);
+    NetDormancy = DORM_Initial;
+
+    // 默认效果为血瓶（+25生命值），其他效果Actor在蓝图类中替换
+    GameplayEffectClass = UAuraHealthPotionEffect::StaticClass();
+}
+
+void AAuraEffectActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(AAuraEffectActor, bPooled);
 }
 
 /**
@@ -55,52 +85,55 @@ AAuraEffectActor::AAuraEffectActor()
  *
  * 功能说明：
  * 1. 检测进入范围的Actor是否拥有能力系统接口
- * 2. 获取其属性集并修改属性值
- * 3. 应用效果后销毁自身
+ * 2. 应用按类缓存的GameplayEffect规格；没有设置GameplayEffectClass时输出错误，效果Actor不被拾取
+ * 3. 应用效果后回收到对象池
  *
  */
 void AAuraEffectActor::OnOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
     UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
     bool bFromSweep, const FHitResult& SweepResult)
 {
-    /**
-     * TODO: 需要改为应用GameplayEffect，现在使用const_cast作为临时解决方案
-     */
+    // 拾取只在服务器上处理，客户端通过属性复制和bPooled得到结果
+    if (!HasAuthority() || bPooled) return;
+
      // 检查OtherActor是否实现了IAbilitySystemInterface接口
      // 只有拥有能力系统的Actor（如玩家、敌人）才能接收效果
     if (IAbilitySystemInterface* ASCInterface = Cast<IAbilitySystemInterface>(OtherActor))
     {
         /**
-         * 获取目标Actor的AuraAttributeSet
-         * 步骤：
-         * 1. 通过ASCInterface获取目标的能力系统组件
-         * 2. 从能力系统组件中获取特定类型的属性集（UAuraAttributeSet）
-         * 3. 使用StaticClass()获取UAuraAttributeSet的类信息
-         */
-        const UAuraAttributeSet* AuraAttributeSet = Cast<UAuraAttributeSet>(
-            ASCInterface->GetAbilitySystemComponent()->GetAttributeSet(UAuraAttributeSet::StaticClass())
-        );
-
-        /**
-         * 使用const_cast将const指针转换为非const指针
-         * 这是临时的hack方法，用于绕过GAS的限制
-         *
+         * 受到效果视为交战，延迟创建ASC的敌人在这里创建
+         * 客户端上尚未复制过来的ASC为空，此时不处理
          */
-        UAuraAttributeSet* MutableAuraAttributeSet = const_cast<UAuraAttributeSet*>(AuraAttributeSet);
+        if (AAuraEnemy* Enemy = Cast<AAuraEnemy>(OtherActor))
+        {
+            Enemy->NotifyEngaged();
+        }
+        UAbilitySystemComponent* TargetASC = ASCInterface->GetAbilitySystemComponent();
+        if (!TargetASC) return;
 
         /**
-         * 修改目标的生命值属性（增加25点）
-         * 直接调用属性集的Setter函数
-
+         * GameplayEffect方式
+         * 规格按效果Actor类缓存，拾取时只复制一次规格并应用，
+         * 效果经过ASC的聚合、标签和复制流程
          */
-        MutableAuraAttributeSet->SetHealth(AuraAttributeSet->GetHealth() + 25.f);
+        UAuraEffectSpecCacheSubsystem* SpecCache = GetWorld()->GetSubsystem<UAuraEffectSpecCacheSubsystem>();
+        const FGameplayEffectSpecHandle SpecHandle = SpecCache ? SpecCache->GetOutgoingSpec(this) : FGameplayEffectSpecHandle();
+        if (!SpecHandle.IsValid())
+        {
+            UE_LOG(LogAura, Error, TEXT("效果Actor %s 没有设置GameplayEffectClass，拾取不生效"), *GetNameSafe(GetClass()));
+            return;
+        }
+        TargetASC->ApplyGameplayEffectSpecToSelf(*SpecHandle.Data.Get());
 
         /**
-         * 应用效果后销毁Actor
-         * 模拟一次性的消耗品（如血瓶）
-         * Destroy(): 标记Actor为待销毁，在下一帧清理
+         * 应用效果后回收到对象池
+         * 模拟一次性的消耗品（如血瓶），不再销毁Actor，
+         * 按RespawnDelay在原地重新出现或等待刷新点复用，不产生UObject分配和垃圾回收
          */
-        Destroy();
+        if (UAuraPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UAuraPickupPoolSubsystem>())
+        {
+            PickupPool->ReleasePickup(this);
+        }
     }
 }
 
@@ -142,9 +175,121 @@ void AAuraEffectActor::BeginPlay()
      */
     Sphere->OnComponentBeginOverlap.AddDynamic(this, &AAuraEffectActor::OnOverlap);
 
+    // 关卡中摆放的效果Actor从一开始就交给实例化渲染
+    UpdateInstancedVisuals();
 }
 
+/**
+ * MakeOutgoingSpec 函数
+ * 效果Actor没有ASC，效果上下文只记录来源对象（效果Actor类默认对象），不设置施加者
+ */
+FGameplayEffectSpecHandle AAuraEffectActor::MakeOutgoingSpec() const
+{
+    if (!GameplayEffectClass) return FGameplayEffectSpecHandle();
+
+    FGameplayEffectContextHandle EffectContext(UAbilitySystemGlobals::Get().AllocGameplayEffectContext());
+    EffectContext.AddSourceObject(this);
 
+    const UGameplayEffect* GameplayEffect = GameplayEffectClass->GetDefaultObject<UGameplayEffect>();
+    FGameplayEffectSpecHandle SpecHandle(new FGameplayEffectSpec(GameplayEffect, EffectContext, EffectLevel));
 
+    for (const TPair<FGameplayTag, float>& Magnitude : SetByCallerMagnitudes)
+    {
+        SpecHandle.Data->SetSetByCallerMagnitude(Magnitude.Key, Magnitude.Value);
+    }
+    SpecHandle.Data->DynamicGrantedTags.AppendTags(DynamicGrantedTags);
 
+    return SpecHandle;
+}
 
+/**
+ * EndPlay 函数
+ * 正常情况下效果Actor不再被销毁，这里的计数用于发现仍在直接销毁效果Actor的代码
+ */
+void AAuraEffectActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UAuraPickupVisualsSubsystem* PickupVisuals = GetWorld()->GetSubsystem<UAuraPickupVisualsSubsystem>())
+    {
+        PickupVisuals->HidePickup(this);
+    }
+
+    if (HasAuthority() && EndPlayReason == EEndPlayReason::Destroyed)
+    {
+        if (UAuraPickupPoolSubsystem* PickupPool = GetWorld()->GetSubsystem<UAuraPickupPoolSubsystem>())
+        {
+            PickupPool->NotifyPickupDestroyed(this);
+        }
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * DeactivateForPool 函数
+ * 回收后Actor仍然存在于世界中，只是不可见、不参与碰撞
+ */
+void AAuraEffectActor::DeactivateForPool()
+{
+    if (!HasAuthority() || bPooled) return;
+
+    // 休眠中的Actor属性变化不会复制，先刷新一次，复制完成后自动回到休眠
+    FlushNetDormancy();
+
+    bPooled = true;
+    ApplyPooledState();
+}
+
+void AAuraEffectActor::ActivateFromPool(const FTransform& SpawnTransform)
+{
+    if (!HasAuthority() || !bPooled) return;
+
+    // 先刷新休眠，位置和bPooled的变化才会复制
+    FlushNetDormancy();
+
+    SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+    bPooled = false;
+    ApplyPooledState();
+}
+
+void AAuraEffectActor::PostNetReceiveLocationAndRotation()
+{
+    Super::PostNetReceiveLocationAndRotation();
+
+    UpdateInstancedVisuals();
+}
+
+void AAuraEffectActor::OnRep_Pooled()
+{
+    ApplyPooledState();
+}
+
+void AAuraEffectActor::ApplyPooledState()
+{
+    SetActorHiddenInGame(bPooled);
+    SetActorEnableCollision(!bPooled);
+
+    UpdateInstancedVisuals();
+}
+
+/**
+ * UpdateInstancedVisuals 函数
+ * 专用服务器上没有实例化渲染子系统，网格组件保持原样（本来就不渲染）
+ * 网格组件只隐藏、不销毁：它提供网格、覆盖材质和变换，关闭实例化渲染时可以直接恢复
+ */
+void AAuraEffectActor::UpdateInstancedVisuals()
+{
+    if (!GetDefault<UAuraDeveloperSettings>()->bInstancedPickupVisuals) return;
+
+    UAuraPickupVisualsSubsystem* PickupVisuals = GetWorld()->GetSubsystem<UAuraPickupVisualsSubsystem>();
+    if (!PickupVisuals) return;
+
+    if (bPooled)
+    {
+        PickupVisuals->HidePickup(this);
+    }
+    else if (PickupVisuals->ShowPickup(this, Mesh->GetStaticMesh(), Mesh->OverrideMaterials, Mesh->GetComponentTransform()))
+    {
+        Mesh->SetHiddenInGame(true);
+    }
+}
@@ -0,0 +1,75 @@
+// Copyright Amor
+
+
+#include "Animation/AuraAnimationSharing.h"
+#include "AnimationSharingManager.h"
+#include "AnimationSharingSetup.h"
+#include "Character/AuraEnemy.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Game/AuraDeveloperSettings.h"
+
+#include "Aura/Aura.h"
+
+UAuraAnimationSharingStateProcessor::UAuraAnimationSharingStateProcessor()
+{
+    AnimationStateEnum = StaticEnum<EAuraAnimationSharingState>();
+}
+
+/**
+ * ProcessActorState 函数
+ * 只读取敌人缓存的原型和移动组件的速度，每个敌人每帧的开销只有几次读取
+ */
+void UAuraAnimationSharingStateProcessor::ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState, bool& bShouldProcess)
+{
+    const AAuraEnemy* Enemy = Cast<AAuraEnemy>(InActor);
+    if (!Enemy)
+    {
+        bShouldProcess = false;
+        return;
+    }
+
+    OutState = AuraAnimationSharing::GetState(Enemy->GetAnimationSharingArchetype(), Enemy->GetAnimationMovementState());
+    bShouldProcess = true;
+}
+
+void UAuraAnimationSharingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (InWorld.GetNetMode() == NM_DedicatedServer || !UAnimationSharingManager::AnimationSharingEnabled()) return;
+
+    const TSoftObjectPtr<UAnimationSharingSetup>& SetupAsset = GetDefault<UAuraDeveloperSettings>()->AnimationSharingSetup;
+    if (SetupAsset.IsNull()) return;
+
+    if (UAnimationSharingSetup* Setup = SetupAsset.LoadSynchronous())
+    {
+        UAnimationSharingManager::CreateAnimationSharingManager(&InWorld, Setup);
+    }
+    else
+    {
+        UE_LOG(LogAura, Warning, TEXT("无法加载动画共享设置 %s"), *SetupAsset.ToString());
+    }
+}
+
+void UAuraAnimationSharingSubsystem::RegisterEnemy(AActor* Enemy, const USkeletalMeshComponent* Mesh) const
+{
+    UAnimationSharingManager* SharingManager = UAnimationSharingManager::GetAnimationSharingManager(GetWorld());
+    const USkeletalMesh* SkeletalMesh = Mesh ? Mesh->GetSkeletalMeshAsset() : nullptr;
+    if (!SharingManager || !SkeletalMesh) return;
+
+    SharingManager->RegisterActorWithSkeletonBP(Enemy, SkeletalMesh->GetSkeleton());
+}
+
+void UAuraAnimationSharingSubsystem::UnregisterEnemy(AActor* Enemy) const
+{
+    if (UAnimationSharingManager* SharingManager = UAnimationSharingManager::GetAnimationSharingManager(GetWorld()))
+    {
+        SharingManager->UnregisterActor(Enemy);
+    }
+}
+
+bool UAuraAnimationSharingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,44 @@
+// Copyright Amor
+
+
+#include "Animation/AuraEnemyAnimInstance.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+/**
+ * PreUpdate 函数
+ * 在游戏线程上调用，只复制数据，不做任何计算
+ */
+void FAuraEnemyAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+    FAnimInstanceProxy::PreUpdate(InAnimInstance, DeltaSeconds);
+
+    const ACharacter* Character = Cast<ACharacter>(InAnimInstance->TryGetPawnOwner());
+    const UCharacterMovementComponent* MovementComponent = Character ? Character->GetCharacterMovement() : nullptr;
+    if (!MovementComponent)
+    {
+        Velocity = FVector::ZeroVector;
+        bHasAcceleration = false;
+        bIsFalling = false;
+        return;
+    }
+
+    Velocity = MovementComponent->Velocity;
+    bHasAcceleration = !MovementComponent->GetCurrentAcceleration().IsNearlyZero();
+    bIsFalling = MovementComponent->IsFalling();
+}
+
+/**
+ * NativeThreadSafeUpdateAnimation 函数
+ * 只访问代理中的副本和本实例的属性，不访问任何其他UObject
+ */
+void UAuraEnemyAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+    Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+    const FAuraEnemyAnimInstanceProxy& AnimProxy = GetProxyOnAnyThread<FAuraEnemyAnimInstanceProxy>();
+
+    GroundSpeed = AnimProxy.Velocity.Size2D();
+    bShouldMove = GroundSpeed > MoveSpeedThreshold && AnimProxy.bHasAcceleration;
+    bIsFalling = AnimProxy.bIsFalling;
+}
@@ -2,6 +2,7 @@
 
 #include "Character/AuraCharacter.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Components/CapsuleComponent.h"
 
 #include "AbilitySystemComponent.h"
 #include "Player/AuraPlayerState.h"
@@ -72,6 +73,12 @@ AAuraCharacter::AAuraCharacter()
      */
     bUseControllerRotationYaw = false;
 
+    /**
+     * 玩家角色不是可选中的目标，关闭悬停代理的碰撞
+     * 避免光标检测命中玩家自己而挡住身后的敌人
+     */
+    HoverProxy->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
  
 }
 
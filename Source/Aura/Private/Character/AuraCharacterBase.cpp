@@ -1,13 +1,23 @@
 // Copyright Amor
 
 #include "Character/AuraCharacterBase.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "AbilitySystemComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
+#include "Engine/NetDriver.h"
+#include "Game/AuraReplicationGraph.h"
+
+#include "Aura/Aura.h"
 
 /**
  * AAuraCharacterBase 构造函数
  * 初始化角色和武器组件
  * 构造函数在对象创建时调用，用于设置默认值和初始化组件
  */
-AAuraCharacterBase::AAuraCharacterBase()
+AAuraCharacterBase::AAuraCharacterBase(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
 {
     /**
      * 设置此角色不需要每帧调用Tick()函数
@@ -78,6 +88,32 @@ AAuraCharacterBase::AAuraCharacterBase()
      * 3. 使用QueryAndPhysics：同时用于射线检测和物理模拟
      */
     Weapon->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+    /**
+     * 角色胶囊体和网格忽略选中目标通道（该通道默认被阻挡）
+     * 选中检测只由悬停代理负责，避免射线检测物理资产中的每一个骨骼刚体
+     * 项目设置中的Pawn和CharacterMesh碰撞预设也忽略该通道，这里保证蓝图改用其他预设时同样生效
+     */
+    GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Target, ECR_Ignore);
+    GetMesh()->SetCollisionResponseToChannel(ECC_Target, ECR_Ignore);
+
+    /**
+     * 创建悬停代理
+     * 附加到根胶囊体上，默认尺寸与角色胶囊体相近，可在蓝图中调整
+     *
+     * 碰撞设置：
+     * - QueryOnly: 只参与射线/重叠查询，不参与物理模拟
+     * - 忽略所有通道，只阻挡ECC_Target，因此不会被摄像机、可见性检测命中
+     * - 不产生重叠事件，也不影响导航网格
+     */
+    HoverProxy = CreateDefaultSubobject<UCapsuleComponent>("HoverProxy");
+    HoverProxy->SetupAttachment(GetRootComponent());
+    HoverProxy->InitCapsuleSize(40.f, 90.f);
+    HoverProxy->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    HoverProxy->SetCollisionResponseToAllChannels(ECR_Ignore);
+    HoverProxy->SetCollisionResponseToChannel(ECC_Target, ECR_Block);
+    HoverProxy->SetGenerateOverlapEvents(false);
+    HoverProxy->SetCanEverAffectNavigation(false);
 }
 
 /**
@@ -118,6 +154,80 @@ UAbilitySystemComponent* AAuraCharacterBase::GetAbilitySystemComponent() const
     return AbilitySystemComponent;
 }
 
+/**
+ * SetSignificanceBucket 函数
+ * 只在等级变化时由重要性子系统调用，不会每帧重复设置
+ */
+void AAuraCharacterBase::SetSignificanceBucket(EAuraSignificanceBucket Bucket, const FAuraSignificanceBucketSettings& Settings)
+{
+    SignificanceBucket = Bucket;
+
+    // Actor本身和ASC（主动效果的周期计算等）
+    SetActorTickInterval(Settings.TickInterval);
+    if (AbilitySystemComponent)
+    {
+        AbilitySystemComponent->SetComponentTickInterval(Settings.TickInterval);
+    }
+
+    /**
+     * 动画
+     * 受预算分配器管理的网格：分配器根据重要性和总预算决定每个网格的更新频率，
+     * 超出预算时优先降低不重要的网格，这里不能再设置固定的Tick间隔
+     * 其他网格：角色网格和武器网格使用相同的更新频率，避免武器与手部脱节
+     */
+    USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh());
+    IAnimationBudgetAllocator* BudgetAllocator = BudgetedMesh ? IAnimationBudgetAllocator::Get(GetWorld()) : nullptr;
+    if (BudgetAllocator && BudgetAllocator->GetEnabled())
+    {
+        const float Significance = 1.f - static_cast<float>(Bucket) / static_cast<float>(EAuraSignificanceBucket::MAX);
+        BudgetAllocator->SetComponentSignificance(BudgetedMesh, Significance);
+    }
+    else
+    {
+        GetMesh()->SetComponentTickInterval(Settings.AnimationTickInterval);
+    }
+    if (Weapon)
+    {
+        Weapon->SetComponentTickInterval(Settings.AnimationTickInterval);
+    }
+
+    GetCharacterMovement()->SetComponentTickInterval(Settings.MovementTickInterval);
+
+    /**
+     * 网络更新频率只在服务器上有意义
+     * 使用复制图时，复制图只在Actor加入时读取一次NetUpdateFrequency，需要同步修改
+     */
+    if (HasAuthority())
+    {
+        SetNetUpdateFrequency(Settings.NetUpdateFrequency);
+
+        const UNetDriver* NetDriver = GetNetDriver();
+        if (UAuraReplicationGraph* ReplicationGraph = NetDriver ? Cast<UAuraReplicationGraph>(NetDriver->GetReplicationDriver()) : nullptr)
+        {
+            ReplicationGraph->SetActorReplicationFrequency(this, Settings.NetUpdateFrequency);
+        }
+    }
+}
+
+/**
+ * ResetSignificance 函数
+ * 组件的默认Tick间隔取自组件模板（蓝图类中的组件或类默认对象的子对象），蓝图中修改过的值同样能恢复
+ */
+void AAuraCharacterBase::ResetSignificance()
+{
+    const AAuraCharacterBase* CharacterCDO = GetClass()->GetDefaultObject<AAuraCharacterBase>();
+    const UActorComponent* MeshTemplate = Cast<UActorComponent>(GetMesh()->GetArchetype());
+    const UActorComponent* MovementTemplate = Cast<UActorComponent>(GetCharacterMovement()->GetArchetype());
+
+    FAuraSignificanceBucketSettings DefaultSettings;
+    DefaultSettings.TickInterval = CharacterCDO->GetActorTickInterval();
+    DefaultSettings.AnimationTickInterval = MeshTemplate ? MeshTemplate->GetComponentTickInterval() : 0.f;
+    DefaultSettings.MovementTickInterval = MovementTemplate ? MovementTemplate->GetComponentTickInterval() : 0.f;
+    DefaultSettings.NetUpdateFrequency = CharacterCDO->GetNetUpdateFrequency();
+
+    SetSignificanceBucket(EAuraSignificanceBucket::High, DefaultSettings);
+}
+
 /**
  * BeginPlay 函数
  * 当游戏开始或角色被生成时调用
@@ -3,6 +3,12 @@
 #include "Character/AuraEnemy.h"
 #include "AbilitySystem/AuraAbilitySystemComponent.h"
 #include "AbilitySystem/AuraAttributeSet.h"
+#include "Interaction/AuraEnemyRegistry.h"
+#include "Interaction/AuraHighlightSubsystem.h"
+#include "Game/AuraDeveloperSettings.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Net/UnrealNetwork.h"
 
 #include "Aura/Aura.h"
 
@@ -11,31 +17,31 @@
  * 初始化敌人角色的属性和组件，特别是碰撞设置和GAS组件
  * 构造函数在对象创建时执行，用于设置默认值和初始化组件
  */
-AAuraEnemy::AAuraEnemy()
+AAuraEnemy::AAuraEnemy(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
     /**
-     * 设置网格（Mesh）对可见性碰撞通道（ECC_Visibility）的响应为阻塞（Block）
-     * 这使得当执行射线检测（如鼠标光标检测）时，射线会在这个网格处停止并返回命中结果
-     *
-     * 碰撞通道说明：
-     * - ECC_Visibility: 可见性碰撞通道，通常用于射线检测，判断物体是否可见
-     * - ECR_Block: 阻塞响应，射线检测会在这个物体上停止并返回命中信息
-     *
-     * 功能说明：
-     * 1. 使敌人可以被鼠标光标射线检测到
-     * 2. 支持玩家通过鼠标悬停或选择敌人
-     * 3. 这是实现IEnemyInterface的基础，确保CursorTrace函数能正确检测到敌人
+     * 动画预算
+     * 分配器开启时（a.Budget.Enabled），所有敌人网格共享一个游戏线程动画预算（a.Budget.BudgetMs），
+     * 超出预算时按重要性逐步降低更新频率并插值，而不是让帧时间随敌人数量线性增长
+     * 重要性由UAuraSignificanceSubsystem按距离和可见性设置（见AAuraCharacterBase::SetSignificanceBucket）
+     */
+    if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+    {
+        BudgetedMesh->SetAutoCalculateSignificance(false);
+    }
+
+    /**
+     * 延迟模式（bLazyEnemyAbilitySystem）下ASC和属性集不作为默认子对象创建，
+     * 由服务器在首次交战时创建（见CreateAbilitySystem），未交战的敌人只保存DormantAttributes
+     * 该设置在构造函数（类默认对象）中读取，修改后需要重启编辑器
      */
-    GetMesh()->SetCollisionResponseToChannel(ECC_Visibility, ECR_Block);
+    if (GetDefault<UAuraDeveloperSettings>()->bLazyEnemyAbilitySystem) return;
 
     /**
      * 创建自定义能力系统组件实例
      * CreateDefaultSubobject<>: 在构造函数中创建UObject子对象的Unreal标准方法
      *
-     * 设计说明：
-     * - "AbilitySystemComponent": 组件名称，在编辑器中标识此组件
-     * - UAuraAbilitySystemComponent: 自定义的能力系统组件类，继承自UAbilitySystemComponent
-     *
      * 敌人GAS设计：
      * 1. 敌人角色直接在自身创建GAS组件，而不是从PlayerState获取
      * 2. 这是因为敌人通常不需要跨死亡保持状态，且不是玩家控制的
@@ -45,41 +51,14 @@ AAuraEnemy::AAuraEnemy()
 
     /**
      * 设置能力系统组件的网络复制属性和复制模式
-     *
-     * 1. 启用能力系统组件的网络复制功能
-     * SetIsReplicated(true): 将这个组件标记为需要网络复制，确保在网络游戏中被同步到所有客户端
-     * 这是基础设置，告诉网络系统这个组件需要被复制
-     * 敌人通常需要网络复制，以便所有玩家看到相同的状态
+     * Minimal: 敌人的AI逻辑主要在服务器运行，客户端只需要接收结果，节省网络带宽
      */
     AbilitySystemComponent->SetIsReplicated(true);
-
-    /**
-     * 2. 设置能力系统组件的具体复制模式
-     * SetReplicationMode(): 指定组件如何在不同客户端之间同步数据
-     * EGameplayEffectReplicationMode::Minimal: 最小复制模式，只复制必要的数据，节省带宽
-     *
-     * 最小复制模式说明：
-     * - 对于AI敌人，通常只需要复制重要的状态变化，不需要像玩家那样频繁同步
-     * - 节省网络带宽，特别是有大量敌人时
-     * - 复制GameplayEffects但不复制GameplayCues（视觉效果客户端本地处理）
-     *
-     * 与玩家角色的区别：
-     * 玩家角色使用Mixed模式，而敌人使用Minimal模式，因为：
-     * 1. 玩家需要客户端预测以减少延迟感
-     * 2. 敌人的AI逻辑主要在服务器运行，客户端只需要接收结果
-     */
     AbilitySystemComponent->SetReplicationMode(EGameplayEffectReplicationMode::Minimal);
 
     /**
      * 创建自定义属性集实例
-     * CreateDefaultSubobject<>: 同样使用Unreal的标准组件创建方法
-     * "AttributeSet": 组件名称，在编辑器中标识此属性集
-     * UAuraAttributeSet: 自定义的属性集类，继承自UAttributeSet
-     *
-     * 敌人属性集特点：
-     * 1. 敌人有自己的属性集，独立于玩家
-     * 2. 可以在编辑器中配置敌人的基础属性（生命值、攻击力等）
-     * 3. 支持不同的敌人类型有不同的属性配置
+     * 可以在编辑器中配置敌人的基础属性，支持不同的敌人类型有不同的属性配置
      */
     AttributeSet = CreateDefaultSubobject<UAuraAttributeSet>("AttributeSet");
 }
@@ -90,7 +69,7 @@ AAuraEnemy::AAuraEnemy()
  *
  * 功能说明：
  * 1. 调用父类的BeginPlay确保基础初始化完成
- * 2. 初始化敌人的能力系统Actor信息
+ * 2. 初始化敌人的能力系统Actor信息（延迟模式下推迟到首次交战时创建）
  * 3. 执行敌人特有的游戏逻辑初始化
  */
 void AAuraEnemy::BeginPlay()
@@ -101,6 +80,99 @@ void AAuraEnemy::BeginPlay()
      */
     Super::BeginPlay();
 
+    // 刚生成的敌人在空闲一段时间后才进入网络休眠
+    LastNetActivityTime = GetWorld()->GetTimeSeconds();
+
+    /**
+     * 默认模式：ASC和属性集是默认子对象，服务器和客户端都在这里初始化
+     * 延迟模式：属性值先保存在休眠副本中，客户端等待服务器创建的组件复制过来（OnRep_AbilitySystem）
+     */
+    DormantAttributes = UAuraAttributeSet::MakeDormantDefaults();
+    if (AbilitySystemComponent)
+    {
+        InitAbilitySystem();
+    }
+
+    /**
+     * 注册到敌人注册表
+     * 屏幕空间拾取等系统通过注册表获取所有存活的敌人
+     * 客户端上初始复制的bPooled可能已经为true（对象池中的敌人），此时不注册
+     */
+    ResolveAnimationSharingArchetype();
+    if (!bPooled)
+    {
+        SetActiveRegistration(true);
+    }
+}
+
+void AAuraEnemy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(AAuraEnemy, bPooled);
+    DOREPLIFETIME(AAuraEnemy, ReplicatedAbilitySystem);
+}
+
+/**
+ * CreateAbilitySystem 函数
+ * 延迟模式下在服务器上运行时创建ASC和属性集，两者都以敌人为Outer
+ * 默认模式下ASC是默认子对象，这里直接返回
+ * 运行时创建的对象使用与默认子对象不同的名称，不会与蓝图资产中序列化的子对象冲突
+ */
+void AAuraEnemy::CreateAbilitySystem()
+{
+    if (!HasAuthority() || AbilitySystemComponent) return;
+
+    /**
+     * 创建自定义能力系统组件实例
+     * NewObject + RegisterComponent: 运行时创建组件的标准方法
+     *
+     * 敌人GAS设计：
+     * 1. 敌人角色直接在自身创建GAS组件，而不是从PlayerState获取
+     * 2. 这是因为敌人通常不需要跨死亡保持状态，且不是玩家控制的
+     * 3. 简化了敌人AI的逻辑，所有能力状态都在角色自身
+     */
+    UAuraAbilitySystemComponent* AuraASC = NewObject<UAuraAbilitySystemComponent>(this, TEXT("LazyAbilitySystemComponent"));
+
+    /**
+     * 启用网络复制，运行时创建的组件作为动态组件复制到客户端
+     *
+     * 最小复制模式说明：
+     * - 对于AI敌人，通常只需要复制重要的状态变化，不需要像玩家那样频繁同步
+     * - 节省网络带宽，特别是有大量敌人时
+     * - 玩家角色使用Mixed模式以支持客户端预测，敌人的AI逻辑主要在服务器运行
+     */
+    AuraASC->SetIsReplicated(true);
+    AuraASC->SetReplicationMode(EGameplayEffectReplicationMode::Minimal);
+    AuraASC->RegisterComponent();
+
+    /**
+     * 创建属性集并写入休眠期间保存的属性值
+     * ASC只在InitializeComponent时收集已有的属性集子对象，运行时创建的属性集需要手动添加
+     */
+    UAuraAttributeSet* AuraAttributeSet = NewObject<UAuraAttributeSet>(this, TEXT("LazyAttributeSet"));
+    AuraAttributeSet->InitFromDormant(DormantAttributes);
+    AuraASC->AddAttributeSetSubobject(AuraAttributeSet);
+
+    AbilitySystemComponent = AuraASC;
+    AttributeSet = AuraAttributeSet;
+    ReplicatedAbilitySystem = AuraASC;
+
+    InitAbilitySystem();
+    ForceNetUpdate();
+}
+
+void AAuraEnemy::OnRep_AbilitySystem()
+{
+    if (!ReplicatedAbilitySystem || AbilitySystemComponent == ReplicatedAbilitySystem) return;
+
+    AbilitySystemComponent = ReplicatedAbilitySystem;
+    AttributeSet = const_cast<UAuraAttributeSet*>(ReplicatedAbilitySystem->GetSet<UAuraAttributeSet>());
+    InitAbilitySystem();
+}
+
+void AAuraEnemy::InitAbilitySystem()
+{
     /**
      * 初始化能力系统Actor信息
      * InitAbilityActorInfo(): 建立Owner-Avatar关系，初始化GAS系统
@@ -117,6 +189,234 @@ void AAuraEnemy::BeginPlay()
      * 注意：这个函数在服务器和客户端都会被调用，但可能只会在服务器上激活能力
      */
     AbilitySystemComponent->InitAbilityActorInfo(this, this);
+
+    // 重要性系统可能已经降低了该敌人的Tick频率，新创建的ASC与Actor保持一致
+    AbilitySystemComponent->SetComponentTickInterval(GetActorTickInterval());
+
+    /**
+     * 网络休眠的唤醒条件：属性变化、受到GameplayEffect
+     * 回调在修改发生时立即执行，唤醒后本次修改会在下一次网络更新中复制
+     */
+    if (HasAuthority())
+    {
+        for (const FGameplayAttribute& Attribute : {
+            UAuraAttributeSet::GetHealthAttribute(),
+            UAuraAttributeSet::GetMaxHealthAttribute(),
+            UAuraAttributeSet::GetManaAttribute(),
+            UAuraAttributeSet::GetMaxManaAttribute() })
+        {
+            AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddUObject(this, &AAuraEnemy::OnAttributeChangedForDormancy);
+        }
+        AbilitySystemComponent->OnGameplayEffectAppliedDelegateToSelf.AddUObject(this, &AAuraEnemy::OnGameplayEffectAppliedForDormancy);
+    }
+}
+
+/**
+ * NotifyEngaged 函数
+ * 对象池中的敌人不会交战，回收时保留已创建的ASC，下一次取出时不需要重新创建
+ */
+void AAuraEnemy::NotifyEngaged()
+{
+    if (!HasAuthority() || bPooled) return;
+
+    MarkNetActive();
+    CreateAbilitySystem();
+}
+
+/**
+ * MarkNetActive 函数
+ * 只负责唤醒，重新进入休眠由UAuraNetDormancySubsystem在敌人空闲一段时间后决定
+ */
+void AAuraEnemy::MarkNetActive()
+{
+    if (!HasAuthority()) return;
+
+    LastNetActivityTime = GetWorld()->GetTimeSeconds();
+    if (NetDormancy > DORM_Awake)
+    {
+        SetNetDormancy(DORM_Awake);
+    }
+}
+
+void AAuraEnemy::OnAttributeChangedForDormancy(const FOnAttributeChangeData& Data)
+{
+    MarkNetActive();
+}
+
+void AAuraEnemy::OnGameplayEffectAppliedForDormancy(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle)
+{
+    MarkNetActive();
+}
+
+float AAuraEnemy::GetCurrentHealth() const
+{
+    if (const UAuraAttributeSet* AuraAttributeSet = Cast<UAuraAttributeSet>(AttributeSet))
+    {
+        return AuraAttributeSet->GetHealth();
+    }
+    return DormantAttributes.Health;
+}
+
+void AAuraEnemy::SetCurrentHealth(float NewHealth)
+{
+    if (!HasAuthority()) return;
+
+    if (AbilitySystemComponent && AttributeSet)
+    {
+        AbilitySystemComponent->SetNumericAttributeBase(UAuraAttributeSet::GetHealthAttribute(), NewHealth);
+    }
+    else
+    {
+        DormantAttributes.Health = NewHealth;
+    }
+}
+
+/**
+ * DeactivateForPool 函数
+ * 回收后Actor仍然存在于世界中，只是不可见、不参与碰撞和Tick，
+ * 不会产生UObject分配或垃圾回收的开销
+ */
+void AAuraEnemy::DeactivateForPool()
+{
+    if (!HasAuthority() || bPooled) return;
+
+    // 先重置GAS状态（移除所有效果），再恢复属性默认值，否则当前值仍包含效果的修改
+    if (UAuraAbilitySystemComponent* AuraASC = Cast<UAuraAbilitySystemComponent>(AbilitySystemComponent))
+    {
+        AuraASC->ResetRuntimeState();
+    }
+    if (UAuraAttributeSet* AuraAttributeSet = Cast<UAuraAttributeSet>(AttributeSet))
+    {
+        AuraAttributeSet->ResetToDefaults();
+    }
+    DormantAttributes = UAuraAttributeSet::MakeDormantDefaults();
+
+    bPooled = true;
+    ApplyPooledState();
+    ForceNetUpdate();
+
+    // 对象池中的敌人没有任何变化，复制完bPooled后进入休眠
+    SetNetDormancy(DORM_DormantAll);
+}
+
+void AAuraEnemy::ActivateFromPool(const FTransform& SpawnTransform)
+{
+    if (!HasAuthority() || !bPooled) return;
+
+    // 先唤醒，位置和bPooled的变化才会复制
+    MarkNetActive();
+
+    SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+
+    bPooled = false;
+    ApplyPooledState();
+    ForceNetUpdate();
+}
+
+void AAuraEnemy::OnRep_Pooled()
+{
+    ApplyPooledState();
+}
+
+void AAuraEnemy::ApplyPooledState()
+{
+    // 进入对象池前取消高亮，避免下一次取出时仍带着轮廓
+    if (bPooled)
+    {
+        UnHighlightActor();
+    }
+
+    SetActorHiddenInGame(bPooled);
+    SetActorEnableCollision(!bPooled);
+    SetActorTickEnabled(!bPooled);
+
+    // Actor的Tick开关不影响组件，移动组件和网格需要单独处理
+    GetCharacterMovement()->StopMovementImmediately();
+    GetCharacterMovement()->SetComponentTickEnabled(!bPooled);
+    GetMesh()->SetComponentTickEnabled(!bPooled);
+
+    /**
+     * 注册表状态与是否在对象池中保持一致
+     * 注销会使槽位代数加一，玩家控制器中指向该敌人的悬停/范围选敌句柄随即失效
+     */
+    SetActiveRegistration(!bPooled);
+}
+
+/**
+ * SetActiveRegistration 函数
+ * 对象池中的敌人不可见，不需要参与拾取，也不应占用动画共享的实例
+ */
+void AAuraEnemy::SetActiveRegistration(bool bRegistered)
+{
+    UWorld* World = GetWorld();
+    UAuraEnemyRegistry* EnemyRegistry = World->GetSubsystem<UAuraEnemyRegistry>();
+    const UAuraAnimationSharingSubsystem* AnimationSharing = World->GetSubsystem<UAuraAnimationSharingSubsystem>();
+
+    if (bRegistered)
+    {
+        if (EnemyRegistry)
+        {
+            EnemyRegistry->RegisterEnemy(this);
+        }
+        if (AnimationSharing)
+        {
+            AnimationSharing->RegisterEnemy(this, GetMesh());
+        }
+    }
+    else
+    {
+        if (EnemyRegistry)
+        {
+            EnemyRegistry->UnregisterEnemy(this);
+        }
+        if (AnimationSharing)
+        {
+            AnimationSharing->UnregisterEnemy(this);
+        }
+    }
+}
+
+/**
+ * ResolveAnimationSharingArchetype 函数
+ * 敌人类一定已经加载，匹配的条目（自身或父类）的软引用可以直接解析，不会触发加载
+ */
+void AAuraEnemy::ResolveAnimationSharingArchetype()
+{
+    int32 BestDepth = INDEX_NONE;
+    for (const FAuraAnimationSharingArchetypeMapping& Mapping : GetDefault<UAuraDeveloperSettings>()->AnimationSharingArchetypes)
+    {
+        const UClass* MappedClass = Mapping.EnemyClass.Get();
+        if (!MappedClass || !GetClass()->IsChildOf(MappedClass)) continue;
+
+        int32 Depth = 0;
+        for (const UClass* Class = MappedClass; Class; Class = Class->GetSuperClass())
+        {
+            ++Depth;
+        }
+        if (Depth > BestDepth)
+        {
+            BestDepth = Depth;
+            AnimationSharingArchetype = Mapping.Archetype;
+        }
+    }
+}
+
+EAuraEnemyMovementState AAuraEnemy::GetAnimationMovementState() const
+{
+    return GetVelocity().SizeSquared2D() > FMath::Square(AnimationSharingWalkSpeed)
+        ? EAuraEnemyMovementState::Walk
+        : EAuraEnemyMovementState::Idle;
+}
+
+/**
+ * EndPlay 函数
+ * 敌人被销毁或关卡卸载时调用，从敌人注册表中注销
+ */
+void AAuraEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    SetActiveRegistration(false);
+
+    Super::EndPlay(EndPlayReason);
 }
 
 /**
@@ -136,41 +436,36 @@ void AAuraEnemy::BeginPlay()
 void AAuraEnemy::HighlightActor()
 {
     /**
-     * 启用角色网格的Custom Depth渲染
-     * SetRenderCustomDepth(true): 启用自定义深度渲染，允许后期处理效果
-     *
-     * 注意事项：
-     * 1. 需要在项目设置中启用"Custom Depth-Stencil Pass"
-     * 2. 这个功能对性能有一定影响，特别是大量敌人同时高亮时
-     * 3. 可以优化为只在需要时启用，不需要时禁用
+     * 通过高亮管理器提交请求，而不是直接修改组件
+     * 光标扫过一群敌人时，同一帧内的高亮/取消高亮会被合并，帧末每个组件最多更新一次渲染状态
      */
-    GetMesh()->SetRenderCustomDepth(true);
+    UAuraHighlightSubsystem* HighlightSubsystem = GetWorld()->GetSubsystem<UAuraHighlightSubsystem>();
+    if (!HighlightSubsystem) return;
 
     /**
-     * 设置角色网格的Custom Depth模板值为红色高亮
-     * SetCustomDepthStencilValue(): 分配一个模板值，用于后期材质识别
-     * CUSTOM_DEPTH_RED: 通常在Aura.h中定义的常量，如250
-     *
-     * 模板值分配策略：
-     * - 不同的值可以对应不同的高亮颜色（红、蓝、绿等）
-     * - 可以在材质蓝图中根据模板值应用不同的颜色
-     * - 支持多色高亮，如敌人、盟友、物品等不同颜色
+     * 高亮类别决定模板值和颜色，敌人默认为Enemy类别（CUSTOM_DEPTH_RED，250）
+     * 具体使用Custom Depth还是叠加材质由项目设置中的HighlightBackend决定
      */
-    GetMesh()->SetCustomDepthStencilValue(CUSTOM_DEPTH_RED);
+    const EAuraHighlightCategory Category = GetHighlightCategory();
 
     /**
-     * 启用武器网格的Custom Depth渲染
-     * 武器也需要高亮，以保持视觉一致性
-     * 如果武器是独立的网格组件，需要单独设置
+     * 高亮角色网格
+     *
+     * Custom Depth后端的注意事项：
+     * 1. 需要在项目设置中启用"Custom Depth-Stencil Pass"
+     * 2. 这个功能对性能有一定影响，特别是大量敌人同时高亮时
+     *
+     * 模板值分配策略：
+     * - 不同的值对应不同的高亮颜色（见AuraHighlightCategory.h）
+     * - 后期材质根据模板值从材质参数集中读取对应的颜色
      */
-    Weapon->SetRenderCustomDepth(true);
+    HighlightSubsystem->RequestHighlight(GetMesh(), true, Category);
 
     /**
-     * 设置武器网格的Custom Depth模板值为红色高亮
-     * 使用与角色相同的模板值，确保它们使用相同的高亮颜色
+     * 武器也需要高亮，以保持视觉一致性
+     * 使用与角色相同的类别，确保它们使用相同的高亮颜色
      */
-    Weapon->SetCustomDepthStencilValue(CUSTOM_DEPTH_RED);
-
+    HighlightSubsystem->RequestHighlight(Weapon, true, Category);
 }
 
 /**
@@ -185,18 +480,16 @@ void AAuraEnemy::HighlightActor()
  */
 void AAuraEnemy::UnHighlightActor()
 {
+    UAuraHighlightSubsystem* HighlightSubsystem = GetWorld()->GetSubsystem<UAuraHighlightSubsystem>();
+    if (!HighlightSubsystem) return;
+
     /**
-     * 禁用角色网格的Custom Depth渲染
-     * SetRenderCustomDepth(false): 关闭自定义深度渲染
+     * 禁用角色网格和武器的Custom Depth渲染
+     * 同一帧内先高亮再取消高亮的请求会互相抵消，不会产生渲染状态更新
      *
      * 性能优化：
      * 及时禁用Custom Depth可以节省GPU资源，特别是当很多敌人不再被高亮时
      */
-    GetMesh()->SetRenderCustomDepth(false);
-
-    /**
-     * 禁用武器网格的Custom Depth渲染
-     * 确保武器也恢复正常外观
-     */
-    Weapon->SetRenderCustomDepth(false);
-}
\ No newline at end of file
+    HighlightSubsystem->RequestHighlight(GetMesh(), false);
+    HighlightSubsystem->RequestHighlight(Weapon, false);
+}
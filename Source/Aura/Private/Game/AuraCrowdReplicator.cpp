@@ -0,0 +1,87 @@
+// Copyright Amor
+
+
+#include "Game/AuraCrowdReplicator.h"
+#include "Game/AuraCrowdSubsystem.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+
+#include "Aura/Aura.h"
+
+void FAuraCrowdAgentItem::PostReplicatedAdd(const FAuraCrowdAgentArray& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnAgentReplicated(*this);
+    }
+}
+
+void FAuraCrowdAgentItem::PostReplicatedChange(const FAuraCrowdAgentArray& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnAgentReplicated(*this);
+    }
+}
+
+void FAuraCrowdAgentItem::PreReplicatedRemove(const FAuraCrowdAgentArray& InArraySerializer)
+{
+    if (InArraySerializer.Owner)
+    {
+        InArraySerializer.Owner->OnAgentRemoved(*this);
+    }
+}
+
+AAuraCrowdReplicator::AAuraCrowdReplicator()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    bReplicates = true;
+    bAlwaysRelevant = true;
+
+    // 成员只在状态切换时变化，不需要高频率检查
+    SetNetUpdateFrequency(10.f);
+
+    Agents.Owner = this;
+}
+
+void AAuraCrowdReplicator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(AAuraCrowdReplicator, Agents);
+}
+
+void AAuraCrowdReplicator::SetAgent(int32 AgentIndex, TSubclassOf<AAuraEnemy> EnemyClass, const FVector& Location, float Yaw, bool bVisible)
+{
+    if (!HasAuthority() || AgentIndex < 0) return;
+
+    while (Agents.Items.Num() <= AgentIndex)
+    {
+        Agents.MarkItemDirty(Agents.Items.AddDefaulted_GetRef());
+    }
+
+    FAuraCrowdAgentItem& Item = Agents.Items[AgentIndex];
+    Item.EnemyClass = EnemyClass;
+    Item.Location = Location;
+    Item.CompressedYaw = FRotator::CompressAxisToByte(Yaw);
+    Item.bVisible = bVisible;
+    Agents.MarkItemDirty(Item);
+}
+
+void AAuraCrowdReplicator::OnAgentReplicated(const FAuraCrowdAgentItem& Item)
+{
+    if (UAuraCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UAuraCrowdSubsystem>())
+    {
+        Crowd->ApplyReplicatedAgent(Item.ReplicationID, Item.EnemyClass, Item.Location,
+            FRotator::DecompressAxisFromByte(Item.CompressedYaw), Item.bVisible);
+    }
+}
+
+void AAuraCrowdReplicator::OnAgentRemoved(const FAuraCrowdAgentItem& Item)
+{
+    if (UAuraCrowdSubsystem* Crowd = GetWorld()->GetSubsystem<UAuraCrowdSubsystem>())
+    {
+        Crowd->RemoveReplicatedAgent(Item.ReplicationID);
+    }
+}
@@ -0,0 +1,476 @@
+// Copyright Amor
+
+
+#include "Game/AuraCrowdSubsystem.h"
+#include "Game/AuraCrowdReplicator.h"
+#include "Game/AuraDeveloperSettings.h"
+#include "Game/AuraEnemyPoolSubsystem.h"
+#include "Character/AuraEnemy.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * 群体统计
+ * 使用"stat AuraCrowd"查看
+ */
+DECLARE_STATS_GROUP(TEXT("AuraCrowd"), STATGROUP_AuraCrowd, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Crowd Update"), STAT_AuraCrowdUpdate, STATGROUP_AuraCrowd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hydrations"), STAT_AuraCrowdHydrations, STATGROUP_AuraCrowd);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dehydrations"), STAT_AuraCrowdDehydrations, STATGROUP_AuraCrowd);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Crowd Agents"), STAT_AuraCrowdAgents, STATGROUP_AuraCrowd);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Hydrated Agents"), STAT_AuraCrowdHydrated, STATGROUP_AuraCrowd);
+
+int32 UAuraCrowdSubsystem::AddAgent(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& Transform, float Health, uint8 TeamId)
+{
+    if (GetWorld()->GetNetMode() == NM_Client) return INDEX_NONE;
+
+    const int32 TypeIndex = FindOrAddType(EnemyClass);
+    if (TypeIndex == INDEX_NONE) return INDEX_NONE;
+
+    const int32 AgentIndex = AllocateAgent(TypeIndex);
+    Fragments.Locations[AgentIndex] = Transform.GetLocation();
+    Fragments.Yaws[AgentIndex] = Transform.Rotator().Yaw;
+    Fragments.Healths[AgentIndex] = Health >= 0.f ? Health : UAuraAttributeSet::MakeDormantDefaults().Health;
+    Fragments.Teams[AgentIndex] = TeamId;
+
+    UpdateInstance(AgentIndex, true);
+    SyncReplicatedAgent(AgentIndex);
+    return AgentIndex;
+}
+
+/**
+ * AllocateAgent 函数
+ * 优先复用同类型的死亡成员，实例索引不变，不需要增删实例
+ * 服务器和客户端共用：客户端的成员只用于显示，生命值和队伍不使用
+ */
+int32 UAuraCrowdSubsystem::AllocateAgent(int32 TypeIndex)
+{
+    FAuraCrowdType& Type = Types[TypeIndex];
+
+    int32 AgentIndex = INDEX_NONE;
+    if (Type.FreeAgents.Num() > 0)
+    {
+        AgentIndex = Type.FreeAgents.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        AgentIndex = Fragments.Num();
+        Fragments.Locations.AddUninitialized();
+        Fragments.Yaws.AddUninitialized();
+        Fragments.Healths.AddUninitialized();
+        Fragments.Teams.AddUninitialized();
+        Fragments.TypeIndices.Add(static_cast<uint8>(TypeIndex));
+        Fragments.InstanceIndices.Add(Type.Instances ? Type.Instances->AddInstance(FTransform::Identity, true) : INDEX_NONE);
+        Fragments.HydratedActors.AddDefaulted();
+        Fragments.Alive.Add(false);
+        Fragments.Hydrated.Add(false);
+
+        // 每个实例一个随机的动画时间偏移，避免所有成员的顶点动画完全同步
+        if (Type.Instances)
+        {
+            Type.Instances->SetCustomDataValue(Fragments.InstanceIndices[AgentIndex], 0, FMath::FRand());
+        }
+    }
+
+    Fragments.Alive[AgentIndex] = true;
+    ++NumAlive;
+    return AgentIndex;
+}
+
+int32 UAuraCrowdSubsystem::AddAgentFromEnemy(AAuraEnemy* Enemy)
+{
+    if (!IsValid(Enemy) || !Enemy->HasAuthority() || Enemy->IsPooled() || FindAgent(Enemy) != INDEX_NONE) return INDEX_NONE;
+
+    const int32 AgentIndex = AddAgent(Enemy->GetClass(), Enemy->GetActorTransform(), Enemy->GetCurrentHealth(), Enemy->GetTeamId());
+    if (AgentIndex == INDEX_NONE) return INDEX_NONE;
+
+    if (UAuraEnemyPoolSubsystem* EnemyPool = GetWorld()->GetSubsystem<UAuraEnemyPoolSubsystem>())
+    {
+        EnemyPool->ReleaseEnemy(Enemy);
+    }
+    return AgentIndex;
+}
+
+/**
+ * RemoveAgent 函数
+ * 与成员死亡的处理相同，区别只在于由外部调用
+ */
+void UAuraCrowdSubsystem::RemoveAgent(int32 AgentIndex)
+{
+    if (!Fragments.Alive.IsValidIndex(AgentIndex) || !Fragments.Alive[AgentIndex]) return;
+
+    KillAgent(AgentIndex);
+}
+
+int32 UAuraCrowdSubsystem::FindAgent(const AAuraEnemy* Enemy) const
+{
+    const int32* AgentIndex = AgentByActor.Find(Enemy);
+    return AgentIndex ? *AgentIndex : INDEX_NONE;
+}
+
+/**
+ * Tick 函数
+ * 顺序遍历所有成员，按到最近玩家的距离决定水合或脱水
+ * 已水合成员的位置每帧从敌人读回，脱水判断和统计都使用最新位置
+ */
+void UAuraCrowdSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SCOPE_CYCLE_COUNTER(STAT_AuraCrowdUpdate);
+
+    // 客户端只显示服务器复制过来的快照，不模拟
+    UWorld* World = GetWorld();
+    if (World->GetNetMode() == NM_Client || (NumAlive == 0 && bPlacedEnemiesConverted)) return;
+
+    TArray<FVector, TInlineAllocator<8>> Viewpoints;
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+        {
+            Viewpoints.Add(Pawn->GetActorLocation());
+        }
+    }
+
+    // 没有玩家时保持当前状态不变
+    if (Viewpoints.Num() == 0) return;
+
+    const UAuraDeveloperSettings* Settings = GetDefault<UAuraDeveloperSettings>();
+    if (!bPlacedEnemiesConverted)
+    {
+        bPlacedEnemiesConverted = true;
+        if (Settings->bCrowdConvertPlacedEnemies)
+        {
+            ConvertPlacedEnemies(Viewpoints);
+        }
+    }
+    if (NumAlive == 0) return;
+
+    const double HydrateRadiusSquared = FMath::Square(static_cast<double>(Settings->CrowdHydrateRadius));
+    const double DehydrateRadiusSquared = FMath::Square(static_cast<double>(FMath::Max(Settings->CrowdDehydrateRadius, Settings->CrowdHydrateRadius)));
+    int32 TransitionsLeft = Settings->CrowdMaxTransitionsPerFrame;
+
+    for (int32 AgentIndex = 0; AgentIndex < Fragments.Num(); ++AgentIndex)
+    {
+        if (!Fragments.Alive[AgentIndex]) continue;
+
+        if (Fragments.Hydrated[AgentIndex])
+        {
+            // 水合后的敌人被回收（死亡）或销毁，成员随之死亡
+            AAuraEnemy* Enemy = Fragments.HydratedActors[AgentIndex].Get();
+            if (!IsValid(Enemy) || Enemy->IsPooled())
+            {
+                KillAgent(AgentIndex);
+                continue;
+            }
+            Fragments.Locations[AgentIndex] = Enemy->GetActorLocation();
+        }
+
+        const FVector& Location = Fragments.Locations[AgentIndex];
+        double MinDistanceSquared = TNumericLimits<double>::Max();
+        for (const FVector& Viewpoint : Viewpoints)
+        {
+            MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(Location, Viewpoint));
+        }
+
+        if (TransitionsLeft <= 0) continue;
+
+        if (Fragments.Hydrated[AgentIndex])
+        {
+            if (MinDistanceSquared > DehydrateRadiusSquared)
+            {
+                DehydrateAgent(AgentIndex);
+                --TransitionsLeft;
+            }
+        }
+        else if (MinDistanceSquared <= HydrateRadiusSquared)
+        {
+            if (HydrateAgent(AgentIndex))
+            {
+                --TransitionsLeft;
+            }
+        }
+    }
+
+    SET_DWORD_STAT(STAT_AuraCrowdAgents, NumAlive);
+    SET_DWORD_STAT(STAT_AuraCrowdHydrated, NumHydrated);
+}
+
+TStatId UAuraCrowdSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraCrowdSubsystem, STATGROUP_Tickables);
+}
+
+bool UAuraCrowdSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * FindOrAddType 函数
+ * 第一次遇到某个敌人类时为它创建一个实例化网格组件
+ * 网格相对于Actor的偏移取自CDO的骨骼网格，实例与水合后的敌人位置、朝向一致
+ */
+int32 UAuraCrowdSubsystem::FindOrAddType(TSubclassOf<AAuraEnemy> EnemyClass)
+{
+    if (!EnemyClass) return INDEX_NONE;
+
+    if (const int32* TypeIndex = TypeIndexByClass.Find(EnemyClass))
+    {
+        return *TypeIndex;
+    }
+
+    const AAuraEnemy* EnemyCDO = EnemyClass->GetDefaultObject<AAuraEnemy>();
+    UStaticMesh* CrowdMesh = EnemyCDO->GetCrowdMesh();
+    if (!CrowdMesh)
+    {
+        UE_LOG(LogAura, Warning, TEXT("敌人类 %s 没有设置CrowdMesh，不能加入群体"), *GetNameSafe(EnemyClass));
+        return INDEX_NONE;
+    }
+
+    // 类型索引保存在uint8中
+    if (Types.Num() > MAX_uint8)
+    {
+        UE_LOG(LogAura, Warning, TEXT("群体类型数量超过上限，忽略敌人类 %s"), *GetNameSafe(EnemyClass));
+        return INDEX_NONE;
+    }
+
+    // 专用服务器不渲染，群体类型只保存数据
+    FAuraCrowdType& Type = Types.AddDefaulted_GetRef();
+    Type.EnemyClass = EnemyClass;
+    Type.MeshOffset = EnemyCDO->GetMesh()->GetRelativeTransform();
+
+    const int32 TypeIndex = Types.Num() - 1;
+    TypeIndexByClass.Add(EnemyClass, TypeIndex);
+    if (GetWorld()->GetNetMode() == NM_DedicatedServer) return TypeIndex;
+
+    if (!VisualsActor)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Name = TEXT("AuraCrowdVisuals");
+        SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        VisualsActor = GetWorld()->SpawnActor<AActor>(SpawnParams);
+    }
+
+    UHierarchicalInstancedStaticMeshComponent* Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(VisualsActor);
+    Instances->SetStaticMesh(CrowdMesh);
+    Instances->SetMobility(EComponentMobility::Movable);
+    Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Instances->SetCanEverAffectNavigation(false);
+    Instances->SetNumCustomDataFloats(1);
+    if (!VisualsActor->GetRootComponent())
+    {
+        VisualsActor->SetRootComponent(Instances);
+    }
+    else
+    {
+        Instances->SetupAttachment(VisualsActor->GetRootComponent());
+    }
+    Instances->RegisterComponent();
+
+    Types[TypeIndex].Instances = Instances;
+    return TypeIndex;
+}
+
+/**
+ * HydrateAgent 函数
+ * 对象池中的敌人可能刚被另一个成员回收（死亡）并在本帧被重新取出，
+ * 此时先让原来的成员死亡，保证一个敌人只对应一个成员
+ */
+bool UAuraCrowdSubsystem::HydrateAgent(int32 AgentIndex)
+{
+    UAuraEnemyPoolSubsystem* EnemyPool = GetWorld()->GetSubsystem<UAuraEnemyPoolSubsystem>();
+    if (!EnemyPool) return false;
+
+    const FAuraCrowdType& Type = Types[Fragments.TypeIndices[AgentIndex]];
+    const FTransform SpawnTransform(FRotator(0.f, Fragments.Yaws[AgentIndex], 0.f), Fragments.Locations[AgentIndex]);
+
+    AAuraEnemy* Enemy = EnemyPool->AcquireEnemy(Type.EnemyClass, SpawnTransform);
+    if (!Enemy) return false;
+
+    if (const int32* PreviousAgent = AgentByActor.Find(Enemy))
+    {
+        KillAgent(*PreviousAgent);
+    }
+
+    Enemy->SetCurrentHealth(Fragments.Healths[AgentIndex]);
+    Enemy->SetTeamId(Fragments.Teams[AgentIndex]);
+
+    Fragments.HydratedActors[AgentIndex] = Enemy;
+    Fragments.Hydrated[AgentIndex] = true;
+    AgentByActor.Add(Enemy, AgentIndex);
+    ++NumHydrated;
+
+    UpdateInstance(AgentIndex, false);
+    SyncReplicatedAgent(AgentIndex);
+    INC_DWORD_STAT(STAT_AuraCrowdHydrations);
+    return true;
+}
+
+void UAuraCrowdSubsystem::DehydrateAgent(int32 AgentIndex)
+{
+    AAuraEnemy* Enemy = Fragments.HydratedActors[AgentIndex].Get();
+    if (!Enemy) return;
+
+    // 先读回状态，再放回对象池（回收会把属性恢复为默认值）
+    Fragments.Locations[AgentIndex] = Enemy->GetActorLocation();
+    Fragments.Yaws[AgentIndex] = Enemy->GetActorRotation().Yaw;
+    Fragments.Healths[AgentIndex] = Enemy->GetCurrentHealth();
+    Fragments.Teams[AgentIndex] = Enemy->GetTeamId();
+
+    AgentByActor.Remove(Enemy);
+    Fragments.HydratedActors[AgentIndex].Reset();
+    Fragments.Hydrated[AgentIndex] = false;
+    --NumHydrated;
+
+    if (UAuraEnemyPoolSubsystem* EnemyPool = GetWorld()->GetSubsystem<UAuraEnemyPoolSubsystem>())
+    {
+        EnemyPool->ReleaseEnemy(Enemy);
+    }
+
+    UpdateInstance(AgentIndex, true);
+    SyncReplicatedAgent(AgentIndex);
+    INC_DWORD_STAT(STAT_AuraCrowdDehydrations);
+}
+
+void UAuraCrowdSubsystem::KillAgent(int32 AgentIndex)
+{
+    if (Fragments.Hydrated[AgentIndex])
+    {
+        AgentByActor.Remove(Fragments.HydratedActors[AgentIndex].Get());
+        Fragments.HydratedActors[AgentIndex].Reset();
+        Fragments.Hydrated[AgentIndex] = false;
+        --NumHydrated;
+    }
+
+    UpdateInstance(AgentIndex, false);
+    Fragments.Alive[AgentIndex] = false;
+    --NumAlive;
+    Types[Fragments.TypeIndices[AgentIndex]].FreeAgents.Add(AgentIndex);
+    SyncReplicatedAgent(AgentIndex);
+}
+
+/**
+ * UpdateInstance 函数
+ * 隐藏的实例缩放为0，不删除实例，其他成员的实例索引保持不变
+ */
+void UAuraCrowdSubsystem::UpdateInstance(int32 AgentIndex, bool bVisible)
+{
+    const FAuraCrowdType& Type = Types[Fragments.TypeIndices[AgentIndex]];
+    if (!Type.Instances) return;
+
+    const FTransform ActorTransform(FRotator(0.f, Fragments.Yaws[AgentIndex], 0.f), Fragments.Locations[AgentIndex]);
+    FTransform InstanceTransform = Type.MeshOffset * ActorTransform;
+    if (!bVisible)
+    {
+        InstanceTransform.SetScale3D(FVector::ZeroVector);
+    }
+
+    Type.Instances->UpdateInstanceTransform(Fragments.InstanceIndices[AgentIndex], InstanceTransform, true, true);
+}
+
+/**
+ * ConvertPlacedEnemies 函数
+ * 只转换关卡中摆放的敌人（IsNetStartupActor），刷怪逻辑生成的敌人由调用方决定是否加入群体
+ * 先收集再转换：转换会把敌人放回对象池
+ */
+void UAuraCrowdSubsystem::ConvertPlacedEnemies(TConstArrayView<FVector> Viewpoints)
+{
+    const double DehydrateRadiusSquared = FMath::Square(static_cast<double>(GetDefault<UAuraDeveloperSettings>()->CrowdDehydrateRadius));
+
+    TArray<AAuraEnemy*> PlacedEnemies;
+    for (TActorIterator<AAuraEnemy> It(GetWorld()); It; ++It)
+    {
+        AAuraEnemy* Enemy = *It;
+        if (!Enemy->IsNetStartupActor() || Enemy->IsPooled() || !Enemy->GetCrowdMesh()) continue;
+
+        double MinDistanceSquared = TNumericLimits<double>::Max();
+        for (const FVector& Viewpoint : Viewpoints)
+        {
+            MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(Enemy->GetActorLocation(), Viewpoint));
+        }
+        if (MinDistanceSquared > DehydrateRadiusSquared)
+        {
+            PlacedEnemies.Add(Enemy);
+        }
+    }
+
+    for (AAuraEnemy* Enemy : PlacedEnemies)
+    {
+        AddAgentFromEnemy(Enemy);
+    }
+
+    UE_CLOG(PlacedEnemies.Num() > 0, LogAura, Log, TEXT("群体：%d 个关卡中摆放的远处敌人转换为群体成员"), PlacedEnemies.Num());
+}
+
+/**
+ * SyncReplicatedAgent 函数
+ * 复制Actor在联网游戏中第一次需要同步时生成，单机游戏不需要
+ * 已水合或死亡的成员快照为不显示
+ */
+void UAuraCrowdSubsystem::SyncReplicatedAgent(int32 AgentIndex)
+{
+    const ENetMode NetMode = GetWorld()->GetNetMode();
+    if (NetMode != NM_ListenServer && NetMode != NM_DedicatedServer) return;
+
+    if (!Replicator)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Name = TEXT("AuraCrowdReplicator");
+        SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+        Replicator = GetWorld()->SpawnActor<AAuraCrowdReplicator>(SpawnParams);
+        if (!Replicator) return;
+    }
+
+    const bool bVisible = Fragments.Alive[AgentIndex] && !Fragments.Hydrated[AgentIndex];
+    Replicator->SetAgent(AgentIndex, Types[Fragments.TypeIndices[AgentIndex]].EnemyClass,
+        Fragments.Locations[AgentIndex], Fragments.Yaws[AgentIndex], bVisible);
+}
+
+/**
+ * ApplyReplicatedAgent 函数
+ * 客户端第一次收到某个快照时分配本地成员，之后只更新位置、朝向和实例可见性
+ * 快照的敌人类变化（服务器复用了不同类型的成员槽位）时先释放原来的本地成员
+ */
+void UAuraCrowdSubsystem::ApplyReplicatedAgent(int32 ReplicationID, TSubclassOf<AAuraEnemy> EnemyClass, const FVector& Location, float Yaw, bool bVisible)
+{
+    if (GetWorld()->GetNetMode() != NM_Client) return;
+
+    const int32 TypeIndex = FindOrAddType(EnemyClass);
+    int32* ExistingAgent = AgentByReplicationID.Find(ReplicationID);
+    if (ExistingAgent && Fragments.TypeIndices[*ExistingAgent] != TypeIndex)
+    {
+        RemoveReplicatedAgent(ReplicationID);
+        ExistingAgent = nullptr;
+    }
+    if (TypeIndex == INDEX_NONE) return;
+
+    const int32 AgentIndex = ExistingAgent ? *ExistingAgent : AgentByReplicationID.Add(ReplicationID, AllocateAgent(TypeIndex));
+    Fragments.Locations[AgentIndex] = Location;
+    Fragments.Yaws[AgentIndex] = Yaw;
+    UpdateInstance(AgentIndex, bVisible);
+
+    SET_DWORD_STAT(STAT_AuraCrowdAgents, NumAlive);
+}
+
+void UAuraCrowdSubsystem::RemoveReplicatedAgent(int32 ReplicationID)
+{
+    int32 AgentIndex = INDEX_NONE;
+    if (!AgentByReplicationID.RemoveAndCopyValue(ReplicationID, AgentIndex)) return;
+
+    UpdateInstance(AgentIndex, false);
+    Fragments.Alive[AgentIndex] = false;
+    --NumAlive;
+    Types[Fragments.TypeIndices[AgentIndex]].FreeAgents.Add(AgentIndex);
+
+    SET_DWORD_STAT(STAT_AuraCrowdAgents, NumAlive);
+}
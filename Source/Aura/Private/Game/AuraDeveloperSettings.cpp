@@ -0,0 +1,31 @@
+// Copyright Amor
+
+
+#include "Game/AuraDeveloperSettings.h"
+
+static FAuraSignificanceBucketSettings MakeSignificanceBucket(float MaxDistance, float TickInterval, float NetUpdateFrequency)
+{
+    FAuraSignificanceBucketSettings Bucket;
+    Bucket.MaxDistance = MaxDistance;
+    Bucket.TickInterval = TickInterval;
+    Bucket.AnimationTickInterval = TickInterval;
+    Bucket.MovementTickInterval = TickInterval;
+    Bucket.NetUpdateFrequency = NetUpdateFrequency;
+    return Bucket;
+}
+
+UAuraDeveloperSettings::UAuraDeveloperSettings()
+{
+    /**
+     * 重要性等级默认值
+     * High:    1500厘米以内，全频率（网络更新频率与AActor默认值相同）
+     * Medium:  3500厘米以内，约30Hz
+     * Low:     7000厘米以内，约10Hz
+     * Minimal: 更远，约4Hz，网络每秒更新一次
+     */
+    SignificanceBuckets.SetNum(static_cast<int32>(EAuraSignificanceBucket::MAX));
+    SignificanceBuckets[static_cast<int32>(EAuraSignificanceBucket::High)] = MakeSignificanceBucket(1500.f, 0.f, 100.f);
+    SignificanceBuckets[static_cast<int32>(EAuraSignificanceBucket::Medium)] = MakeSignificanceBucket(3500.f, 0.033f, 10.f);
+    SignificanceBuckets[static_cast<int32>(EAuraSignificanceBucket::Low)] = MakeSignificanceBucket(7000.f, 0.1f, 4.f);
+    SignificanceBuckets[static_cast<int32>(EAuraSignificanceBucket::Minimal)] = MakeSignificanceBucket(0.f, 0.25f, 1.f);
+}
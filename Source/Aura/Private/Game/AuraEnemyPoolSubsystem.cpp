@@ -0,0 +1,107 @@
+// Copyright Amor
+
+
+#include "Game/AuraEnemyPoolSubsystem.h"
+#include "Game/AuraDeveloperSettings.h"
+#include "Character/AuraEnemy.h"
+#include "Engine/World.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * 敌人对象池统计
+ * 使用"stat AuraEnemyPool"查看
+ * Misses: 对象池为空时生成的新敌人数量，成波刷怪期间应保持为0（否则需要增加预热数量）
+ */
+DECLARE_STATS_GROUP(TEXT("AuraEnemyPool"), STATGROUP_AuraEnemyPool, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Acquire Enemy"), STAT_AuraEnemyPoolAcquire, STATGROUP_AuraEnemyPool);
+DECLARE_CYCLE_STAT(TEXT("Release Enemy"), STAT_AuraEnemyPoolRelease, STATGROUP_AuraEnemyPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Acquired"), STAT_AuraEnemyPoolAcquired, STATGROUP_AuraEnemyPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Released"), STAT_AuraEnemyPoolReleased, STATGROUP_AuraEnemyPool);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pool Misses"), STAT_AuraEnemyPoolMisses, STATGROUP_AuraEnemyPool);
+
+void UAuraEnemyPoolSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (InWorld.GetNetMode() == NM_Client) return;
+
+    for (const FAuraEnemyPoolPrewarm& Entry : GetDefault<UAuraDeveloperSettings>()->EnemyPoolPrewarm)
+    {
+        if (UClass* EnemyClass = Entry.EnemyClass.LoadSynchronous())
+        {
+            Prewarm(EnemyClass, Entry.Count);
+        }
+        else
+        {
+            UE_LOG(LogAura, Warning, TEXT("敌人对象池预热：无法加载敌人类 %s"), *Entry.EnemyClass.ToString());
+        }
+    }
+}
+
+void UAuraEnemyPoolSubsystem::Prewarm(TSubclassOf<AAuraEnemy> EnemyClass, int32 Count)
+{
+    if (!EnemyClass || GetWorld()->GetNetMode() == NM_Client) return;
+
+    FAuraEnemyPool& Pool = Pools.FindOrAdd(EnemyClass);
+    Pool.Inactive.Reserve(Count);
+
+    // 预热的敌人生成在原点并立即回收，隐藏且没有碰撞，不会影响场景
+    while (Pool.Inactive.Num() < Count)
+    {
+        AAuraEnemy* Enemy = SpawnEnemy(EnemyClass, FTransform::Identity);
+        if (!Enemy) break;
+
+        Enemy->DeactivateForPool();
+        Pool.Inactive.Add(Enemy);
+    }
+}
+
+AAuraEnemy* UAuraEnemyPoolSubsystem::AcquireEnemy(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& SpawnTransform)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AuraEnemyPoolAcquire);
+
+    if (!EnemyClass || GetWorld()->GetNetMode() == NM_Client) return nullptr;
+
+    // 跳过在对象池中被外部销毁的实例（例如关卡流送卸载）
+    FAuraEnemyPool& Pool = Pools.FindOrAdd(EnemyClass);
+    while (Pool.Inactive.Num() > 0)
+    {
+        AAuraEnemy* Enemy = Pool.Inactive.Pop(EAllowShrinking::No);
+        if (IsValid(Enemy))
+        {
+            Enemy->ActivateFromPool(SpawnTransform);
+            INC_DWORD_STAT(STAT_AuraEnemyPoolAcquired);
+            return Enemy;
+        }
+    }
+
+    // 对象池为空：直接生成，之后回收时进入对象池
+    INC_DWORD_STAT(STAT_AuraEnemyPoolMisses);
+    INC_DWORD_STAT(STAT_AuraEnemyPoolAcquired);
+    return SpawnEnemy(EnemyClass, SpawnTransform);
+}
+
+void UAuraEnemyPoolSubsystem::ReleaseEnemy(AAuraEnemy* Enemy)
+{
+    SCOPE_CYCLE_COUNTER(STAT_AuraEnemyPoolRelease);
+
+    if (!IsValid(Enemy) || !Enemy->HasAuthority() || Enemy->IsPooled()) return;
+
+    Enemy->DeactivateForPool();
+    Pools.FindOrAdd(Enemy->GetClass()).Inactive.Add(Enemy);
+    INC_DWORD_STAT(STAT_AuraEnemyPoolReleased);
+}
+
+int32 UAuraEnemyPoolSubsystem::GetNumInactive(TSubclassOf<AAuraEnemy> EnemyClass) const
+{
+    const FAuraEnemyPool* Pool = Pools.Find(EnemyClass);
+    return Pool ? Pool->Inactive.Num() : 0;
+}
+
+AAuraEnemy* UAuraEnemyPoolSubsystem::SpawnEnemy(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& SpawnTransform) const
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+    return GetWorld()->SpawnActor<AAuraEnemy>(EnemyClass, SpawnTransform, SpawnParams);
+}
@@ -0,0 +1,284 @@
+// Copyright Amor
+
+
+#include "Game/AuraNetDormancySubsystem.h"
+#include "Game/AuraDeveloperSettings.h"
+#include "Character/AuraEnemy.h"
+#include "Actor/AuraEffectActor.h"
+#include "Interaction/AuraEnemyRegistry.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/NetworkObjectList.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "ReplicationGraph.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * 敌人网络休眠开关
+ * 1: 静止且空闲的敌人进入网络休眠（默认）
+ * 0: 所有敌人保持唤醒，用于对比开启前后每次网络更新考虑的Actor数量
+ */
+static TAutoConsoleVariable<int32> CVarAuraEnemyNetDormancy(
+    TEXT("aura.Net.EnemyDormancy"),
+    1,
+    TEXT("敌人网络休眠：1 = 静止且空闲的敌人进入休眠，0 = 所有敌人保持唤醒"),
+    ECVF_Default);
+
+/**
+ * 网络统计
+ * 使用"stat AuraNet"查看
+ * Considered: 每次网络更新实际考虑的Actor数量（活跃列表），Total: 不使用休眠时需要考虑的数量
+ * 使用复制图时两者都是所有连接之和（见CountGraphConsideredActors）
+ */
+DECLARE_STATS_GROUP(TEXT("AuraNet"), STATGROUP_AuraNet, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Dormancy Update"), STAT_AuraNetDormancyUpdate, STATGROUP_AuraNet);
+DECLARE_CYCLE_STAT(TEXT("Net Stats Sample"), STAT_AuraNetStatsSample, STATGROUP_AuraNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Net Actors Total"), STAT_AuraNetActorsTotal, STATGROUP_AuraNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Net Actors Considered"), STAT_AuraNetActorsConsidered, STATGROUP_AuraNet);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Dormant Enemies"), STAT_AuraNetDormantEnemies, STATGROUP_AuraNet);
+
+/**
+ * Tick 函数
+ * 休眠检查和统计采样分开计时，采样的开销不计入Dormancy Update
+ */
+void UAuraNetDormancySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    UWorld* World = GetWorld();
+    if (World->GetNetMode() == NM_Client || World->GetNetMode() == NM_Standalone) return;
+
+    UpdateDormancy();
+    UpdateNetStats();
+}
+
+/**
+ * UpdateDormancy 函数
+ * 轮转检查一部分敌人，开销与敌人总数无关
+ */
+void UAuraNetDormancySubsystem::UpdateDormancy()
+{
+    SCOPE_CYCLE_COUNTER(STAT_AuraNetDormancyUpdate);
+
+    const bool bEnabled = CVarAuraEnemyNetDormancy.GetValueOnGameThread() != 0;
+    if (!bEnabled)
+    {
+        if (bWasEnabled)
+        {
+            WakeAllEnemies();
+            bWasEnabled = false;
+        }
+        return;
+    }
+    bWasEnabled = true;
+
+    UWorld* World = GetWorld();
+
+    const UAuraEnemyRegistry* Registry = World->GetSubsystem<UAuraEnemyRegistry>();
+    const TArray<TWeakObjectPtr<AActor>>* Enemies = Registry ? &Registry->GetEnemies() : nullptr;
+    if (Enemies && Enemies->Num() > 0)
+    {
+        const UAuraDeveloperSettings* Settings = GetDefault<UAuraDeveloperSettings>();
+        const double Now = World->GetTimeSeconds();
+        const int32 NumToCheck = FMath::Min(Settings->EnemyNetDormancyChecksPerFrame, Enemies->Num());
+
+        for (int32 Count = 0; Count < NumToCheck; ++Count)
+        {
+            if (NextIndex >= Enemies->Num())
+            {
+                NextIndex = 0;
+            }
+            if (AAuraEnemy* Enemy = Cast<AAuraEnemy>((*Enemies)[NextIndex].Get()))
+            {
+                UpdateEnemyDormancy(Enemy, Now, Settings->EnemyNetDormancyDelay);
+            }
+            ++NextIndex;
+        }
+    }
+}
+
+/**
+ * UpdateEnemyDormancy 函数
+ * 移动中的敌人记为活跃，停下后等待EnemyNetDormancyDelay秒再休眠，
+ * 保证最后的位置和速度已经复制到客户端
+ */
+void UAuraNetDormancySubsystem::UpdateEnemyDormancy(AAuraEnemy* Enemy, double Now, double DormancyDelay) const
+{
+    if (!Enemy->GetVelocity().IsNearlyZero(1.f))
+    {
+        Enemy->MarkNetActive();
+        return;
+    }
+
+    if (Enemy->NetDormancy == DORM_Awake && Now - Enemy->GetLastNetActivityTime() > DormancyDelay)
+    {
+        Enemy->SetNetDormancy(DORM_DormantAll);
+    }
+}
+
+void UAuraNetDormancySubsystem::WakeAllEnemies() const
+{
+    const UAuraEnemyRegistry* Registry = GetWorld()->GetSubsystem<UAuraEnemyRegistry>();
+    if (!Registry) return;
+
+    for (const TWeakObjectPtr<AActor>& Enemy : Registry->GetEnemies())
+    {
+        if (AAuraEnemy* AuraEnemy = Cast<AAuraEnemy>(Enemy.Get()))
+        {
+            AuraEnemy->MarkNetActive();
+        }
+    }
+}
+
+/**
+ * UpdateNetStats 函数
+ * 统计需要遍历所有复制Actor（使用复制图时还要乘以连接数），每帧计算会抵消休眠节省的开销，
+ * 因此只在收集统计数据时（打开了stat分组）每NetStatsSampleInterval秒采样一次；统计为累加器，两次采样之间保持不变
+ */
+void UAuraNetDormancySubsystem::UpdateNetStats()
+{
+#if STATS
+    if (!FThreadStats::IsCollectingData()) return;
+
+    const double Now = FPlatformTime::Seconds();
+    if (Now - LastNetStatsSampleTime < NetStatsSampleInterval) return;
+    LastNetStatsSampleTime = Now;
+
+    SCOPE_CYCLE_COUNTER(STAT_AuraNetStatsSample);
+
+    const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+    if (!NetDriver) return;
+
+    const FNetworkObjectList& NetworkObjects = NetDriver->GetNetworkObjectList();
+    if (Cast<UReplicationGraph>(NetDriver->GetReplicationDriver()))
+    {
+        SET_DWORD_STAT(STAT_AuraNetActorsTotal, NetworkObjects.GetAllObjects().Num() * NetDriver->ClientConnections.Num());
+        SET_DWORD_STAT(STAT_AuraNetActorsConsidered, CountGraphConsideredActors(NetDriver));
+    }
+    else
+    {
+        SET_DWORD_STAT(STAT_AuraNetActorsTotal, NetworkObjects.GetAllObjects().Num());
+        SET_DWORD_STAT(STAT_AuraNetActorsConsidered, NetworkObjects.GetActiveObjects().Num());
+    }
+
+    uint32 NumDormantEnemies = 0;
+    if (const UAuraEnemyRegistry* Registry = GetWorld()->GetSubsystem<UAuraEnemyRegistry>())
+    {
+        for (const TWeakObjectPtr<AActor>& Enemy : Registry->GetEnemies())
+        {
+            if (Enemy.IsValid() && Enemy->NetDormancy > DORM_Awake)
+            {
+                ++NumDormantEnemies;
+            }
+        }
+    }
+    SET_DWORD_STAT(STAT_AuraNetDormantEnemies, NumDormantEnemies);
+#endif
+}
+
+/**
+ * CountGraphConsideredActors 函数
+ * 复制图对每个连接只收集视点附近格子中的Actor，对该连接休眠的Actor直接跳过
+ * 视点取连接的视图目标，没有视图目标的连接只计算始终相关的Actor
+ */
+int32 UAuraNetDormancySubsystem::CountGraphConsideredActors(const UNetDriver* NetDriver) const
+{
+    int32 NumConsidered = 0;
+    for (const UNetConnection* Connection : NetDriver->ClientConnections)
+    {
+        const AActor* ViewTarget = Connection ? Connection->ViewTarget.Get() : nullptr;
+        for (const TSharedPtr<FNetworkObjectInfo>& ObjectInfo : NetDriver->GetNetworkObjectList().GetAllObjects())
+        {
+            const AActor* Actor = ObjectInfo.IsValid() ? ObjectInfo->Actor : nullptr;
+            if (!Actor || Actor->NetDormancy > DORM_Awake) continue;
+
+            if (Actor->bAlwaysRelevant
+                || (ViewTarget && FVector::DistSquared(Actor->GetActorLocation(), ViewTarget->GetActorLocation()) <= Actor->GetNetCullDistanceSquared()))
+            {
+                ++NumConsidered;
+            }
+        }
+    }
+    return NumConsidered;
+}
+
+/**
+ * LogReport 函数
+ * 不使用复制图时，活跃列表就是网络驱动每次更新遍历的Actor，休眠的Actor只在所有连接都休眠时才从中移除
+ * 使用复制图时按连接估算（见CountGraphConsideredActors）
+ * 对比aura.Net.EnemyDormancy为0和1时的Considered比例即为开启前后的差异
+ */
+void UAuraNetDormancySubsystem::LogReport() const
+{
+    UWorld* World = GetWorld();
+    const UNetDriver* NetDriver = World->GetNetDriver();
+    if (!NetDriver || World->GetNetMode() == NM_Client)
+    {
+        UE_LOG(LogAura, Warning, TEXT("aura.Net.DormancyReport: 只能在服务器上使用"));
+        return;
+    }
+
+    const FNetworkObjectList& NetworkObjects = NetDriver->GetNetworkObjectList();
+    const bool bReplicationGraph = Cast<UReplicationGraph>(NetDriver->GetReplicationDriver()) != nullptr;
+    const int32 NumConnections = NetDriver->ClientConnections.Num();
+    const int32 NumTotal = NetworkObjects.GetAllObjects().Num() * (bReplicationGraph ? NumConnections : 1);
+    const int32 NumConsidered = bReplicationGraph ? CountGraphConsideredActors(NetDriver) : NetworkObjects.GetActiveObjects().Num();
+    const int32 NumDormantAll = NetworkObjects.GetDormantObjectsOnAllConnections().Num();
+
+    int32 NumEnemies = 0;
+    int32 NumDormantEnemies = 0;
+    for (TActorIterator<AAuraEnemy> It(World); It; ++It)
+    {
+        ++NumEnemies;
+        NumDormantEnemies += It->NetDormancy > DORM_Awake ? 1 : 0;
+    }
+
+    int32 NumEffectActors = 0;
+    int32 NumDormantEffectActors = 0;
+    for (TActorIterator<AAuraEffectActor> It(World); It; ++It)
+    {
+        ++NumEffectActors;
+        NumDormantEffectActors += It->NetDormancy > DORM_Awake ? 1 : 0;
+    }
+
+    UE_LOG(LogAura, Log, TEXT("网络休眠报告（aura.Net.EnemyDormancy=%d）"), CVarAuraEnemyNetDormancy.GetValueOnGameThread());
+    if (bReplicationGraph)
+    {
+        UE_LOG(LogAura, Log, TEXT("  使用复制图，%d 个连接：以下数量为所有连接之和，考虑的Actor按NetCullDistance估算"), NumConnections);
+    }
+    UE_LOG(LogAura, Log, TEXT("  复制Actor总数（不使用休眠时每次网络更新考虑的数量）: %d"), NumTotal);
+    UE_LOG(LogAura, Log, TEXT("  每次网络更新考虑的Actor: %d（%.1f%%），对所有连接休眠: %d"),
+        NumConsidered, NumTotal > 0 ? 100.0 * NumConsidered / NumTotal : 0.0, NumDormantAll);
+    UE_LOG(LogAura, Log, TEXT("  敌人: %d，休眠 %d"), NumEnemies, NumDormantEnemies);
+    UE_LOG(LogAura, Log, TEXT("  效果Actor: %d，休眠 %d"), NumEffectActors, NumDormantEffectActors);
+}
+
+TStatId UAuraNetDormancySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraNetDormancySubsystem, STATGROUP_Tickables);
+}
+
+bool UAuraNetDormancySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * 网络休眠报告
+ * 用法：aura.Net.DormancyReport
+ * 在服务器（监听服务器或专用服务器控制台）上执行
+ */
+static void RunNetDormancyReport(const TArray<FString>& Args, UWorld* World)
+{
+    if (const UAuraNetDormancySubsystem* DormancySubsystem = World ? World->GetSubsystem<UAuraNetDormancySubsystem>() : nullptr)
+    {
+        DormancySubsystem->LogReport();
+    }
+}
+
+static FAutoConsoleCommandWithWorldAndArgs AuraNetDormancyReportCommand(
+    TEXT("aura.Net.DormancyReport"),
+    TEXT("输出每次网络更新考虑的Actor比例以及敌人和效果Actor的休眠数量。用法：aura.Net.DormancyReport"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunNetDormancyReport));
@@ -0,0 +1,101 @@
+// Copyright Amor
+
+
+#include "Game/AuraPickupPoolSubsystem.h"
+#include "Actor/AuraEffectActor.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * 拾取物对象池统计
+ * 使用"stat AuraPickupPool"查看
+ * Pickups Spawned: 对象池为空时生成的新效果Actor数量
+ * Pickups Destroyed: 被销毁的效果Actor数量，正常情况下应为0
+ */
+DECLARE_STATS_GROUP(TEXT("AuraPickupPool"), STATGROUP_AuraPickupPool, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups Acquired"), STAT_AuraPickupPoolAcquired, STATGROUP_AuraPickupPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups Released"), STAT_AuraPickupPoolReleased, STATGROUP_AuraPickupPool);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups Respawned"), STAT_AuraPickupPoolRespawned, STATGROUP_AuraPickupPool);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickups Spawned"), STAT_AuraPickupPoolSpawned, STATGROUP_AuraPickupPool);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickups Destroyed"), STAT_AuraPickupPoolDestroyed, STATGROUP_AuraPickupPool);
+
+AAuraEffectActor* UAuraPickupPoolSubsystem::AcquirePickup(TSubclassOf<AAuraEffectActor> PickupClass, const FTransform& SpawnTransform)
+{
+    if (!PickupClass || GetWorld()->GetNetMode() == NM_Client) return nullptr;
+
+    // 跳过在对象池中被外部销毁的实例（例如关卡流送卸载）
+    FAuraPickupPool& Pool = Pools.FindOrAdd(PickupClass);
+    while (Pool.Inactive.Num() > 0)
+    {
+        AAuraEffectActor* Pickup = Pool.Inactive.Pop(EAllowShrinking::No);
+        if (IsValid(Pickup))
+        {
+            Pickup->ActivateFromPool(SpawnTransform);
+            INC_DWORD_STAT(STAT_AuraPickupPoolAcquired);
+            return Pickup;
+        }
+    }
+
+    // 对象池为空：直接生成，之后被拾取时进入对象池
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+    AAuraEffectActor* Pickup = GetWorld()->SpawnActor<AAuraEffectActor>(PickupClass, SpawnTransform, SpawnParams);
+    if (Pickup)
+    {
+        INC_DWORD_STAT(STAT_AuraPickupPoolSpawned);
+        INC_DWORD_STAT(STAT_AuraPickupPoolAcquired);
+    }
+    return Pickup;
+}
+
+/**
+ * ReleasePickup 函数
+ * 重新出现的定时器只持有弱指针，效果Actor在等待期间被销毁时定时器自然失效
+ */
+void UAuraPickupPoolSubsystem::ReleasePickup(AAuraEffectActor* Pickup)
+{
+    if (!IsValid(Pickup) || !Pickup->HasAuthority() || Pickup->IsPooled()) return;
+
+    Pickup->DeactivateForPool();
+    INC_DWORD_STAT(STAT_AuraPickupPoolReleased);
+
+    const float RespawnDelay = Pickup->GetRespawnDelay();
+    if (RespawnDelay > 0.f)
+    {
+        FTimerHandle RespawnTimer;
+        const FTimerDelegate RespawnDelegate = FTimerDelegate::CreateUObject(
+            this, &UAuraPickupPoolSubsystem::RespawnPickup, TWeakObjectPtr<AAuraEffectActor>(Pickup));
+        GetWorld()->GetTimerManager().SetTimer(RespawnTimer, RespawnDelegate, RespawnDelay, false);
+    }
+    else
+    {
+        Pools.FindOrAdd(Pickup->GetClass()).Inactive.Add(Pickup);
+    }
+}
+
+void UAuraPickupPoolSubsystem::NotifyPickupDestroyed(AAuraEffectActor* Pickup)
+{
+    INC_DWORD_STAT(STAT_AuraPickupPoolDestroyed);
+
+    if (FAuraPickupPool* Pool = Pools.Find(Pickup->GetClass()))
+    {
+        Pool->Inactive.RemoveSingleSwap(Pickup, EAllowShrinking::No);
+    }
+}
+
+int32 UAuraPickupPoolSubsystem::GetNumInactive(TSubclassOf<AAuraEffectActor> PickupClass) const
+{
+    const FAuraPickupPool* Pool = Pools.Find(PickupClass);
+    return Pool ? Pool->Inactive.Num() : 0;
+}
+
+void UAuraPickupPoolSubsystem::RespawnPickup(TWeakObjectPtr<AAuraEffectActor> WeakPickup)
+{
+    AAuraEffectActor* Pickup = WeakPickup.Get();
+    if (!Pickup || !Pickup->IsPooled()) return;
+
+    Pickup->ActivateFromPool(Pickup->GetActorTransform());
+    INC_DWORD_STAT(STAT_AuraPickupPoolRespawned);
+}
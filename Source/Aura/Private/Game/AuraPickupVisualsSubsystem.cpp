@@ -0,0 +1,152 @@
+// Copyright Amor
+
+
+#include "Game/AuraPickupVisualsSubsystem.h"
+#include "Actor/AuraEffectActor.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInterface.h"
+#include "Engine/World.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * 拾取物实例化渲染统计
+ * 使用"stat AuraPickupVisuals"查看
+ */
+DECLARE_STATS_GROUP(TEXT("AuraPickupVisuals"), STATGROUP_AuraPickupVisuals, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickup Mesh Batches"), STAT_AuraPickupVisualsBatches, STATGROUP_AuraPickupVisuals);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Visible Pickup Instances"), STAT_AuraPickupVisualsInstances, STATGROUP_AuraPickupVisuals);
+
+/**
+ * ShowPickup 函数
+ * 已占用实例的效果Actor只更新变换（例如从对象池取出到新的位置）
+ */
+bool UAuraPickupVisualsSubsystem::ShowPickup(const AAuraEffectActor* Pickup, UStaticMesh* StaticMesh, TConstArrayView<TObjectPtr<UMaterialInterface>> Materials, const FTransform& InstanceTransform)
+{
+    // PIE中的进程内专用服务器同样不需要渲染
+    if (!Pickup || !StaticMesh || GetWorld()->GetNetMode() == NM_DedicatedServer) return false;
+
+    if (const FAuraPickupInstance* Existing = InstanceByPickup.Find(Pickup))
+    {
+        Batches[Existing->BatchIndex].Instances->UpdateInstanceTransform(Existing->InstanceIndex, InstanceTransform, true, true);
+        return true;
+    }
+
+    const int32 BatchIndex = FindOrAddBatch(StaticMesh, Materials);
+    FAuraPickupVisualsBatch& Batch = Batches[BatchIndex];
+
+    FAuraPickupInstance Instance;
+    Instance.BatchIndex = BatchIndex;
+    if (Batch.FreeInstances.Num() > 0)
+    {
+        Instance.InstanceIndex = Batch.FreeInstances.Pop(EAllowShrinking::No);
+        Batch.Instances->UpdateInstanceTransform(Instance.InstanceIndex, InstanceTransform, true, true);
+    }
+    else
+    {
+        Instance.InstanceIndex = Batch.Instances->AddInstance(InstanceTransform, true);
+    }
+    InstanceByPickup.Add(Pickup, Instance);
+
+    UpdateStats();
+    return true;
+}
+
+/**
+ * HidePickup 函数
+ * 实例缩放为0后放入空闲列表；RemoveInstance会移动最后一个实例，其他效果Actor记录的索引随之失效
+ */
+void UAuraPickupVisualsSubsystem::HidePickup(const AAuraEffectActor* Pickup)
+{
+    FAuraPickupInstance Instance;
+    if (!InstanceByPickup.RemoveAndCopyValue(Pickup, Instance)) return;
+
+    FAuraPickupVisualsBatch& Batch = Batches[Instance.BatchIndex];
+    if (IsValid(Batch.Instances))
+    {
+        FTransform HiddenTransform;
+        Batch.Instances->GetInstanceTransform(Instance.InstanceIndex, HiddenTransform, true);
+        HiddenTransform.SetScale3D(FVector::ZeroVector);
+        Batch.Instances->UpdateInstanceTransform(Instance.InstanceIndex, HiddenTransform, true, true);
+    }
+    Batch.FreeInstances.Add(Instance.InstanceIndex);
+
+    UpdateStats();
+}
+
+bool UAuraPickupVisualsSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    return !IsRunningDedicatedServer() && Super::ShouldCreateSubsystem(Outer);
+}
+
+bool UAuraPickupVisualsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+/**
+ * FindOrAddBatch 函数
+ * 批次键使用每个材质槽实际生效的材质，覆盖材质与网格自身材质相同的效果Actor仍然合到一起
+ * 实例化网格不参与碰撞和导航，效果Actor的碰撞仍由自己的球体组件处理
+ */
+int32 UAuraPickupVisualsSubsystem::FindOrAddBatch(UStaticMesh* StaticMesh, TConstArrayView<TObjectPtr<UMaterialInterface>> Materials)
+{
+    FAuraPickupVisualsBatchKey Key;
+    Key.Mesh = StaticMesh;
+    TArray<UMaterialInterface*, TInlineAllocator<4>> SlotMaterials;
+    for (int32 MaterialIndex = 0; MaterialIndex < StaticMesh->GetStaticMaterials().Num(); ++MaterialIndex)
+    {
+        UMaterialInterface* Material = Materials.IsValidIndex(MaterialIndex) && Materials[MaterialIndex]
+            ? Materials[MaterialIndex].Get()
+            : StaticMesh->GetMaterial(MaterialIndex);
+        SlotMaterials.Add(Material);
+        Key.Materials.Add(Material);
+    }
+
+    if (const int32* BatchIndex = BatchIndexByKey.Find(Key))
+    {
+        return *BatchIndex;
+    }
+
+    if (!VisualsActor)
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.Name = TEXT("AuraPickupVisuals");
+        SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+        SpawnParams.ObjectFlags |= RF_Transient;
+        VisualsActor = GetWorld()->SpawnActor<AActor>(SpawnParams);
+    }
+
+    UHierarchicalInstancedStaticMeshComponent* Instances = NewObject<UHierarchicalInstancedStaticMeshComponent>(VisualsActor);
+    Instances->SetStaticMesh(StaticMesh);
+    for (int32 MaterialIndex = 0; MaterialIndex < SlotMaterials.Num(); ++MaterialIndex)
+    {
+        Instances->SetMaterial(MaterialIndex, SlotMaterials[MaterialIndex]);
+    }
+    Instances->SetMobility(EComponentMobility::Movable);
+    Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    Instances->SetCanEverAffectNavigation(false);
+    if (!VisualsActor->GetRootComponent())
+    {
+        VisualsActor->SetRootComponent(Instances);
+    }
+    else
+    {
+        Instances->SetupAttachment(VisualsActor->GetRootComponent());
+    }
+    Instances->RegisterComponent();
+
+    FAuraPickupVisualsBatch& Batch = Batches.AddDefaulted_GetRef();
+    Batch.Instances = Instances;
+
+    const int32 BatchIndex = Batches.Num() - 1;
+    BatchIndexByKey.Add(MoveTemp(Key), BatchIndex);
+    return BatchIndex;
+}
+
+void UAuraPickupVisualsSubsystem::UpdateStats() const
+{
+    SET_DWORD_STAT(STAT_AuraPickupVisualsBatches, Batches.Num());
+    SET_DWORD_STAT(STAT_AuraPickupVisualsInstances, InstanceByPickup.Num());
+}
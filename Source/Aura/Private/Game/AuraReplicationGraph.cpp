@@ -0,0 +1,213 @@
+// Copyright Amor
+
+
+#include "Game/AuraReplicationGraph.h"
+#include "Actor/AuraEffectActor.h"
+#include "Character/AuraEnemy.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "UObject/UObjectIterator.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * GatherActorListsForConnection 函数
+ * 列表每帧重建，Pawn切换、视图目标变化不需要额外的通知
+ */
+void UAuraReplicationGraphNode_OwnerConnection::GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params)
+{
+    ReplicationActorList.Reset();
+
+    for (const FNetViewer& Viewer : Params.Viewers)
+    {
+        APlayerController* PlayerController = Cast<APlayerController>(Viewer.InViewer);
+        if (!PlayerController) continue;
+
+        ReplicationActorList.ConditionalAdd(PlayerController);
+        if (APlayerState* PlayerState = PlayerController->PlayerState)
+        {
+            ReplicationActorList.ConditionalAdd(PlayerState);
+        }
+        if (APawn* Pawn = PlayerController->GetPawn())
+        {
+            ReplicationActorList.ConditionalAdd(Pawn);
+        }
+        if (Viewer.ViewTarget && Viewer.ViewTarget != PlayerController && Viewer.ViewTarget->GetIsReplicated())
+        {
+            ReplicationActorList.ConditionalAdd(Viewer.ViewTarget);
+        }
+    }
+
+    Params.OutGatheredReplicationLists.AddReplicationActorList(ReplicationActorList);
+}
+
+void UAuraReplicationGraph::SetActorReplicationFrequency(AActor* Actor, float NetUpdateFrequency)
+{
+    if (FGlobalActorReplicationInfo* GlobalInfo = GlobalActorReplicationInfoMap.Find(Actor))
+    {
+        GlobalInfo->Settings.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(FMath::Max(NetUpdateFrequency, 1.f));
+    }
+}
+
+/**
+ * InitGlobalActorClassSettings 函数
+ * 先设置Aura的按类路由策略，再为所有已加载的复制Actor类（原生类和蓝图类）从CDO构建复制参数
+ * 之后才加载的蓝图类沿用最近的已设置父类的参数
+ */
+void UAuraReplicationGraph::InitGlobalActorClassSettings()
+{
+    Super::InitGlobalActorClassSettings();
+
+    // 玩家控制器和玩家状态由每连接节点和PlayerStateNode处理
+    ClassRepPolicies.Set(AReplicationGraphDebugActor::StaticClass(), EAuraClassRepPolicy::NotRouted);
+    ClassRepPolicies.Set(ALevelScriptActor::StaticClass(), EAuraClassRepPolicy::NotRouted);
+    ClassRepPolicies.Set(APlayerController::StaticClass(), EAuraClassRepPolicy::NotRouted);
+    ClassRepPolicies.Set(APlayerState::StaticClass(), EAuraClassRepPolicy::NotRouted);
+
+    ClassRepPolicies.Set(AInfo::StaticClass(), EAuraClassRepPolicy::RelevantAllConnections);
+    ClassRepPolicies.Set(AGameStateBase::StaticClass(), EAuraClassRepPolicy::RelevantAllConnections);
+
+    ClassRepPolicies.Set(APawn::StaticClass(), EAuraClassRepPolicy::Spatialize_Dynamic);
+    ClassRepPolicies.Set(AAuraEnemy::StaticClass(), EAuraClassRepPolicy::Spatialize_Dormancy);
+    ClassRepPolicies.Set(AAuraEffectActor::StaticClass(), EAuraClassRepPolicy::Spatialize_Dormancy);
+
+    for (TObjectIterator<UClass> It; It; ++It)
+    {
+        UClass* Class = *It;
+        if (!Class->IsChildOf(AActor::StaticClass()) || Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists)) continue;
+
+        // 跳过蓝图编译产生的骨架类和重新实例化的旧类
+        const FString ClassName = Class->GetName();
+        if (ClassName.StartsWith(TEXT("SKEL_")) || ClassName.StartsWith(TEXT("REINST_"))) continue;
+
+        const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+        if (!ActorCDO || !ActorCDO->GetIsReplicated()) continue;
+
+        // 只有进入空间网格的类使用CDO的NetCullDistance，其他类对所有（或所属）连接相关
+        const EAuraClassRepPolicy Policy = GetClassPolicy(ActorCDO);
+        const bool bSpatialize = Policy == EAuraClassRepPolicy::Spatialize_Static
+            || Policy == EAuraClassRepPolicy::Spatialize_Dynamic
+            || Policy == EAuraClassRepPolicy::Spatialize_Dormancy;
+        InitClassReplicationInfo(Class, bSpatialize);
+    }
+}
+
+void UAuraReplicationGraph::InitGlobalGraphNodes()
+{
+    Super::InitGlobalGraphNodes();
+
+    GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+    GridNode->CellSize = GridCellSize;
+    GridNode->SpatialBias = GridSpatialBias;
+    AddGlobalGraphNode(GridNode);
+
+    AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+    AddGlobalGraphNode(AlwaysRelevantNode);
+
+    PlayerStateNode = CreateNewNode<UReplicationGraphNode_PlayerStateFrequencyLimiter>();
+    AddGlobalGraphNode(PlayerStateNode);
+}
+
+void UAuraReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+    Super::InitConnectionGraphNodes(RepGraphConnection);
+
+    UAuraReplicationGraphNode_OwnerConnection* OwnerConnectionNode = CreateNewNode<UAuraReplicationGraphNode_OwnerConnection>();
+    AddConnectionGraphNode(OwnerConnectionNode, RepGraphConnection);
+}
+
+void UAuraReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+    switch (GetClassPolicy(ActorInfo.Actor))
+    {
+    case EAuraClassRepPolicy::RelevantAllConnections:
+        AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+        break;
+
+    case EAuraClassRepPolicy::Spatialize_Static:
+        GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+        break;
+
+    case EAuraClassRepPolicy::Spatialize_Dynamic:
+        GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+        break;
+
+    case EAuraClassRepPolicy::Spatialize_Dormancy:
+        GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+        break;
+
+    case EAuraClassRepPolicy::NotRouted:
+    default:
+        break;
+    }
+}
+
+void UAuraReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+    switch (GetClassPolicy(ActorInfo.Actor))
+    {
+    case EAuraClassRepPolicy::RelevantAllConnections:
+        AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+        break;
+
+    case EAuraClassRepPolicy::Spatialize_Static:
+        GridNode->RemoveActor_Static(ActorInfo);
+        break;
+
+    case EAuraClassRepPolicy::Spatialize_Dynamic:
+        GridNode->RemoveActor_Dynamic(ActorInfo);
+        break;
+
+    case EAuraClassRepPolicy::Spatialize_Dormancy:
+        GridNode->RemoveActor_Dormancy(ActorInfo);
+        break;
+
+    case EAuraClassRepPolicy::NotRouted:
+    default:
+        break;
+    }
+}
+
+/**
+ * GetClassPolicy 函数
+ * 没有按类设置策略的Actor：
+ * - 始终相关的进入AlwaysRelevantNode
+ * - 只对所属连接相关的不路由（本项目中只有玩家控制器，由每连接节点处理）
+ * - 其他进入空间网格
+ */
+EAuraClassRepPolicy UAuraReplicationGraph::GetClassPolicy(const AActor* Actor) const
+{
+    if (const EAuraClassRepPolicy* Policy = ClassRepPolicies.Get(Actor->GetClass()))
+    {
+        return *Policy;
+    }
+
+    if (Actor->bAlwaysRelevant)
+    {
+        return EAuraClassRepPolicy::RelevantAllConnections;
+    }
+    if (Actor->bOnlyRelevantToOwner)
+    {
+        return EAuraClassRepPolicy::NotRouted;
+    }
+    return EAuraClassRepPolicy::Spatialize_Dynamic;
+}
+
+void UAuraReplicationGraph::InitClassReplicationInfo(UClass* Class, bool bSpatialize)
+{
+    const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+
+    FClassReplicationInfo ClassInfo;
+    if (bSpatialize)
+    {
+        ClassInfo.SetCullDistanceSquared(ActorCDO->GetNetCullDistanceSquared());
+    }
+    ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(FMath::Max(ActorCDO->GetNetUpdateFrequency(), 1.f));
+
+    GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+}
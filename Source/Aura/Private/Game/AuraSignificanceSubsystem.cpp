@@ -0,0 +1,200 @@
+// Copyright Amor
+
+
+#include "Game/AuraSignificanceSubsystem.h"
+#include "Game/AuraDeveloperSettings.h"
+#include "Character/AuraCharacterBase.h"
+#include "Interaction/AuraEnemyRegistry.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * 重要性系统开关
+ * 1: 按距离和可见性降低远处敌人的更新频率（默认）
+ * 0: 所有敌人恢复类默认的Tick间隔和网络更新频率，用于对比开启前后的帧时间
+ */
+static TAutoConsoleVariable<int32> CVarAuraSignificanceEnable(
+    TEXT("aura.Significance.Enable"),
+    1,
+    TEXT("重要性系统：1 = 按距离和可见性降低远处敌人的更新频率，0 = 全部恢复类默认的更新频率"),
+    ECVF_Default);
+
+/**
+ * 重要性统计
+ * 使用"stat AuraSignificance"查看评估耗时和各等级的敌人数量
+ */
+DECLARE_STATS_GROUP(TEXT("AuraSignificance"), STATGROUP_AuraSignificance, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Significance Update"), STAT_AuraSignificanceUpdate, STATGROUP_AuraSignificance);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Bucket Changes"), STAT_AuraSignificanceBucketChanges, STATGROUP_AuraSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies High"), STAT_AuraSignificanceHigh, STATGROUP_AuraSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Medium"), STAT_AuraSignificanceMedium, STATGROUP_AuraSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Low"), STAT_AuraSignificanceLow, STATGROUP_AuraSignificance);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemies Minimal"), STAT_AuraSignificanceMinimal, STATGROUP_AuraSignificance);
+
+namespace AuraSignificance
+{
+    /** 超过该时间（秒）没有被渲染的角色视为在屏幕外 */
+    constexpr float OffscreenTolerance = 0.2f;
+
+    const FAuraSignificanceBucketSettings& GetBucketSettings(EAuraSignificanceBucket Bucket)
+    {
+        static const FAuraSignificanceBucketSettings FullRate;
+        const TArray<FAuraSignificanceBucketSettings>& Buckets = GetDefault<UAuraDeveloperSettings>()->SignificanceBuckets;
+        const int32 Index = static_cast<int32>(Bucket);
+        return Buckets.IsValidIndex(Index) ? Buckets[Index] : FullRate;
+    }
+}
+
+/**
+ * ComputeBucket 函数
+ * 按距离阈值从高到低匹配，最后一个等级兜底
+ */
+EAuraSignificanceBucket UAuraSignificanceSubsystem::ComputeBucket(double DistanceSquared, bool bOnScreen)
+{
+    const TArray<FAuraSignificanceBucketSettings>& Buckets = GetDefault<UAuraDeveloperSettings>()->SignificanceBuckets;
+    const int32 LastIndex = static_cast<int32>(EAuraSignificanceBucket::Minimal);
+
+    int32 Index = 0;
+    while (Index < LastIndex && Buckets.IsValidIndex(Index)
+        && DistanceSquared > FMath::Square(static_cast<double>(Buckets[Index].MaxDistance)))
+    {
+        ++Index;
+    }
+
+    if (!bOnScreen)
+    {
+        Index = FMath::Min(Index + 1, LastIndex);
+    }
+    return static_cast<EAuraSignificanceBucket>(Index);
+}
+
+/**
+ * Tick 函数
+ * 先收集所有玩家Pawn的位置，再轮转评估本帧的敌人
+ * 注册表使用RemoveSwap注销，列表顺序会变化，轮转索引越界时从头开始
+ */
+void UAuraSignificanceSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    SCOPE_CYCLE_COUNTER(STAT_AuraSignificanceUpdate);
+
+    const bool bEnabled = CVarAuraSignificanceEnable.GetValueOnGameThread() != 0;
+    if (!bEnabled)
+    {
+        if (bWasEnabled)
+        {
+            ResetAllToDefaults();
+            bWasEnabled = false;
+        }
+        return;
+    }
+    bWasEnabled = true;
+
+    UWorld* World = GetWorld();
+    UAuraEnemyRegistry* Registry = World->GetSubsystem<UAuraEnemyRegistry>();
+    if (!Registry) return;
+
+    const TArray<TWeakObjectPtr<AActor>>& Enemies = Registry->GetEnemies();
+    if (Enemies.Num() == 0) return;
+
+    TArray<FVector, TInlineAllocator<8>> Viewpoints;
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController* PlayerController = It->Get();
+        if (const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+        {
+            Viewpoints.Add(Pawn->GetActorLocation());
+        }
+    }
+
+    // 没有玩家（例如玩家死亡等待重生）时保持当前等级不变
+    if (Viewpoints.Num() == 0) return;
+
+    const UAuraDeveloperSettings* Settings = GetDefault<UAuraDeveloperSettings>();
+    const bool bUseVisibility = Settings->bDemoteOffscreenSignificance && World->GetNetMode() != NM_DedicatedServer;
+    const int32 NumToEvaluate = FMath::Min(Settings->SignificanceUpdatesPerFrame, Enemies.Num());
+
+    for (int32 Count = 0; Count < NumToEvaluate; ++Count)
+    {
+        // 一轮轮转结束：发布本轮统计
+        if (NextIndex >= Enemies.Num())
+        {
+            NextIndex = 0;
+            PublishBucketStats(RotationBucketCounts);
+            FMemory::Memzero(RotationBucketCounts);
+        }
+        if (AAuraCharacterBase* Character = Cast<AAuraCharacterBase>(Enemies[NextIndex].Get()))
+        {
+            EvaluateCharacter(Character, Viewpoints, bUseVisibility);
+        }
+        ++NextIndex;
+    }
+}
+
+/**
+ * EvaluateCharacter 函数
+ * 评估结果同时计入本轮统计，统计不需要额外遍历注册表
+ */
+void UAuraSignificanceSubsystem::EvaluateCharacter(AAuraCharacterBase* Character, TConstArrayView<FVector> Viewpoints, bool bUseVisibility)
+{
+    const FVector Location = Character->GetActorLocation();
+    double MinDistanceSquared = TNumericLimits<double>::Max();
+    for (const FVector& Viewpoint : Viewpoints)
+    {
+        MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector::DistSquared(Location, Viewpoint));
+    }
+
+    const bool bOnScreen = !bUseVisibility || Character->WasRecentlyRendered(AuraSignificance::OffscreenTolerance);
+    const EAuraSignificanceBucket Bucket = ComputeBucket(MinDistanceSquared, bOnScreen);
+    ++RotationBucketCounts[static_cast<int32>(Bucket)];
+    if (Bucket == Character->GetSignificanceBucket()) return;
+
+    Character->SetSignificanceBucket(Bucket, AuraSignificance::GetBucketSettings(Bucket));
+    INC_DWORD_STAT(STAT_AuraSignificanceBucketChanges);
+}
+
+/**
+ * ResetAllToDefaults 函数
+ * 只在关闭的那一帧调用一次，遍历注册表的开销不计入每帧的评估
+ */
+void UAuraSignificanceSubsystem::ResetAllToDefaults()
+{
+    NextIndex = 0;
+    FMemory::Memzero(RotationBucketCounts);
+
+    UAuraEnemyRegistry* Registry = GetWorld()->GetSubsystem<UAuraEnemyRegistry>();
+    if (!Registry) return;
+
+    uint32 Counts[static_cast<int32>(EAuraSignificanceBucket::MAX)] = {};
+    for (const TWeakObjectPtr<AActor>& Enemy : Registry->GetEnemies())
+    {
+        if (AAuraCharacterBase* Character = Cast<AAuraCharacterBase>(Enemy.Get()))
+        {
+            Character->ResetSignificance();
+            ++Counts[static_cast<int32>(EAuraSignificanceBucket::High)];
+        }
+    }
+    PublishBucketStats(Counts);
+}
+
+void UAuraSignificanceSubsystem::PublishBucketStats(const uint32 (&Counts)[static_cast<int32>(EAuraSignificanceBucket::MAX)]) const
+{
+    SET_DWORD_STAT(STAT_AuraSignificanceHigh, Counts[static_cast<int32>(EAuraSignificanceBucket::High)]);
+    SET_DWORD_STAT(STAT_AuraSignificanceMedium, Counts[static_cast<int32>(EAuraSignificanceBucket::Medium)]);
+    SET_DWORD_STAT(STAT_AuraSignificanceLow, Counts[static_cast<int32>(EAuraSignificanceBucket::Low)]);
+    SET_DWORD_STAT(STAT_AuraSignificanceMinimal, Counts[static_cast<int32>(EAuraSignificanceBucket::Minimal)]);
+}
+
+TStatId UAuraSignificanceSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+bool UAuraSignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+    return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
@@ -0,0 +1,83 @@
+// Copyright Amor
+
+
+#include "Interaction/AuraEnemyRegistry.h"
+#include "Interaction/EnemyInterface.h"
+
+FAuraEnemyHandle UAuraEnemyRegistry::RegisterEnemy(AActor* Enemy)
+{
+    if (!Enemy) return FAuraEnemyHandle();
+
+    if (const FAuraEnemyHandle* ExistingHandle = HandleByActor.Find(Enemy))
+    {
+        return *ExistingHandle;
+    }
+
+    IEnemyInterface* EnemyInterface = Cast<IEnemyInterface>(Enemy);
+    if (!EnemyInterface) return FAuraEnemyHandle();
+
+    // 优先复用空闲槽位
+    const int32 SlotIndex = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Slots.AddDefaulted();
+
+    FSlot& Slot = Slots[SlotIndex];
+    Slot.Actor = Enemy;
+    Slot.Enemy = EnemyInterface;
+
+    FAuraEnemyHandle Handle;
+    Handle.Index = SlotIndex;
+    Handle.Generation = Slot.Generation;
+
+    HandleByActor.Add(Enemy, Handle);
+    Enemies.Add(Enemy);
+    return Handle;
+}
+
+void UAuraEnemyRegistry::UnregisterEnemy(AActor* Enemy)
+{
+    FAuraEnemyHandle Handle;
+    if (!HandleByActor.RemoveAndCopyValue(Enemy, Handle)) return;
+
+    // 代数加一使所有旧句柄失效，再把槽位放回空闲列表
+    FSlot& Slot = Slots[Handle.Index];
+    Slot.Actor.Reset();
+    Slot.Enemy = nullptr;
+    ++Slot.Generation;
+    FreeSlots.Add(Handle.Index);
+
+    // 顺序无关，使用RemoveSwap避免移动后续元素
+    Enemies.RemoveSwap(Enemy);
+}
+
+FAuraEnemyHandle UAuraEnemyRegistry::FindHandle(const AActor* Actor) const
+{
+    if (!Actor) return FAuraEnemyHandle();
+
+    const FAuraEnemyHandle* Handle = HandleByActor.Find(Actor);
+    return Handle ? *Handle : FAuraEnemyHandle();
+}
+
+IEnemyInterface* UAuraEnemyRegistry::Resolve(const FAuraEnemyHandle& Handle) const
+{
+    const FSlot* Slot = FindSlot(Handle);
+    return Slot ? Slot->Enemy : nullptr;
+}
+
+AActor* UAuraEnemyRegistry::GetActor(const FAuraEnemyHandle& Handle) const
+{
+    const FSlot* Slot = FindSlot(Handle);
+    return Slot ? Slot->Actor.Get() : nullptr;
+}
+
+/**
+ * FindSlot 函数
+ * 代数不匹配说明敌人已经注销；弱指针失效说明敌人没有经过EndPlay就被回收（例如关卡卸载时）
+ */
+const UAuraEnemyRegistry::FSlot* UAuraEnemyRegistry::FindSlot(const FAuraEnemyHandle& Handle) const
+{
+    if (!Slots.IsValidIndex(Handle.Index)) return nullptr;
+
+    const FSlot& Slot = Slots[Handle.Index];
+    if (Slot.Generation != Handle.Generation || !Slot.Actor.IsValid()) return nullptr;
+
+    return &Slot;
+}
@@ -0,0 +1,288 @@
+// Copyright Amor
+
+
+#include "Interaction/AuraHighlightSubsystem.h"
+#include "Interaction/HighlightInterface.h"
+#include "Character/AuraEnemy.h"
+#include "Game/AuraDeveloperSettings.h"
+#include "Components/MeshComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * 高亮统计
+ * 使用"stat AuraHighlight"查看
+ * Avoided = Requests - Applied：被去重或互相抵消、没有产生渲染状态更新的请求数
+ */
+DECLARE_STATS_GROUP(TEXT("AuraHighlight"), STATGROUP_AuraHighlight, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Highlight Flush"), STAT_AuraHighlightFlush, STATGROUP_AuraHighlight);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Highlight Requests"), STAT_AuraHighlightRequests, STATGROUP_AuraHighlight);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Highlight Updates Applied"), STAT_AuraHighlightApplied, STATGROUP_AuraHighlight);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Highlight Updates Avoided"), STAT_AuraHighlightAvoided, STATGROUP_AuraHighlight);
+
+void UAuraHighlightSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    const UAuraDeveloperSettings* Settings = GetDefault<UAuraDeveloperSettings>();
+    if (Settings->HighlightBackend == EAuraHighlightBackend::OverlayMaterial
+        && !SetHighlightBackend(EAuraHighlightBackend::OverlayMaterial))
+    {
+        UE_LOG(LogAura, Warning, TEXT("HighlightBackend为OverlayMaterial，但没有设置HighlightOverlayMaterial，改用CustomDepth"));
+    }
+}
+
+void UAuraHighlightSubsystem::RequestHighlight(UPrimitiveComponent* Component, bool bHighlighted, EAuraHighlightCategory Category)
+{
+    if (!Component) return;
+
+    ++NumRequestsThisFrame;
+
+    // 同一组件的后续请求覆盖之前的请求，只保留最终状态
+    FPendingHighlight& Pending = PendingHighlights.FindOrAdd(Component);
+    Pending.Component = Component;
+    Pending.bHighlighted = bHighlighted;
+    Pending.Category = Category;
+}
+
+/**
+ * FlushHighlights 函数
+ * 与组件当前状态比较，只有最终状态确实不同时才调用设置函数
+ */
+void UAuraHighlightSubsystem::FlushHighlights()
+{
+    SCOPE_CYCLE_COUNTER(STAT_AuraHighlightFlush);
+
+    uint32 NumApplied = 0;
+    for (const TPair<TObjectKey<UPrimitiveComponent>, FPendingHighlight>& Pair : PendingHighlights)
+    {
+        const FPendingHighlight& Pending = Pair.Value;
+        UPrimitiveComponent* Component = Pending.Component.Get();
+        if (!Component) continue;
+
+        const bool bApplied = Backend == EAuraHighlightBackend::OverlayMaterial
+            ? ApplyOverlayMaterial(Component, Pending)
+            : ApplyCustomDepth(Component, Pending);
+        if (bApplied)
+        {
+            ++NumApplied;
+        }
+    }
+
+    INC_DWORD_STAT_BY(STAT_AuraHighlightRequests, NumRequestsThisFrame);
+    INC_DWORD_STAT_BY(STAT_AuraHighlightApplied, NumApplied);
+    INC_DWORD_STAT_BY(STAT_AuraHighlightAvoided, NumRequestsThisFrame - NumApplied);
+
+    // Reset保留容量，下一帧不需要重新分配
+    PendingHighlights.Reset();
+    NumRequestsThisFrame = 0;
+}
+
+bool UAuraHighlightSubsystem::ApplyCustomDepth(UPrimitiveComponent* Component, const FPendingHighlight& Pending)
+{
+    const int32 StencilValue = AuraHighlight::GetStencilValue(Pending.Category);
+    const bool bRenderCustomDepthChanged = Component->bRenderCustomDepth != Pending.bHighlighted;
+    const bool bStencilChanged = Pending.bHighlighted && Component->CustomDepthStencilValue != StencilValue;
+    if (!bRenderCustomDepthChanged && !bStencilChanged) return false;
+
+    // 两个设置函数都只标记渲染状态为脏，代理在帧末只重建一次
+    if (bStencilChanged)
+    {
+        Component->SetCustomDepthStencilValue(StencilValue);
+    }
+    if (bRenderCustomDepthChanged)
+    {
+        Component->SetRenderCustomDepth(Pending.bHighlighted);
+    }
+    return true;
+}
+
+/**
+ * ApplyOverlayMaterial 函数
+ * 只有网格组件支持叠加材质，其他图元组件忽略
+ * 取消高亮时清除叠加材质，因此该后端不能与网格上原有的叠加材质同时使用
+ */
+bool UAuraHighlightSubsystem::ApplyOverlayMaterial(UPrimitiveComponent* Component, const FPendingHighlight& Pending)
+{
+    UMeshComponent* MeshComponent = Cast<UMeshComponent>(Component);
+    if (!MeshComponent) return false;
+
+    UMaterialInterface* DesiredMaterial = Pending.bHighlighted
+        ? OverlayMaterials[static_cast<int32>(Pending.Category)].Get()
+        : nullptr;
+    if (MeshComponent->GetOverlayMaterial() == DesiredMaterial) return false;
+
+    MeshComponent->SetOverlayMaterial(DesiredMaterial);
+    return true;
+}
+
+bool UAuraHighlightSubsystem::SetHighlightBackend(EAuraHighlightBackend NewBackend, UMaterialInterface* OverlayBaseMaterial)
+{
+    if (NewBackend == EAuraHighlightBackend::OverlayMaterial)
+    {
+        if (!OverlayBaseMaterial)
+        {
+            OverlayBaseMaterial = GetDefault<UAuraDeveloperSettings>()->HighlightOverlayMaterial.LoadSynchronous();
+        }
+        if (!OverlayBaseMaterial) return false;
+
+        CreateOverlayMaterials(OverlayBaseMaterial);
+    }
+
+    Backend = NewBackend;
+    return true;
+}
+
+void UAuraHighlightSubsystem::CreateOverlayMaterials(UMaterialInterface* BaseMaterial)
+{
+    const FName ColorParameter = GetDefault<UAuraDeveloperSettings>()->HighlightOverlayColorParameter;
+
+    OverlayMaterials.Reset(AuraHighlight::NumCategories);
+    for (const FAuraHighlightCategoryInfo& Info : AuraHighlight::Categories)
+    {
+        UMaterialInstanceDynamic* OverlayMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+        OverlayMaterial->SetVectorParameterValue(ColorParameter, AuraHighlight::GetColor(Info.Category));
+        OverlayMaterials.Add(OverlayMaterial);
+    }
+}
+
+void UAuraHighlightSubsystem::ApplyHighlightPalette(UMaterialParameterCollection* Collection) const
+{
+    if (!Collection) return;
+
+    UMaterialParameterCollectionInstance* CollectionInstance = GetWorld()->GetParameterCollectionInstance(Collection);
+    if (!CollectionInstance) return;
+
+    for (const FAuraHighlightCategoryInfo& Info : AuraHighlight::Categories)
+    {
+        CollectionInstance->SetVectorParameterValue(Info.ColorParameterName, AuraHighlight::GetColor(Info.Category));
+    }
+}
+
+void UAuraHighlightSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (NumRequestsThisFrame > 0)
+    {
+        FlushHighlights();
+    }
+}
+
+TStatId UAuraHighlightSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAuraHighlightSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * 高亮后端基准测试
+ * 用法：aura.Benchmark.Highlight [Iterations] [EnemyClassPath]
+ *
+ * 分别生成10、100、1000个敌人，每次迭代先高亮全部敌人再取消高亮，
+ * 每一步都执行FlushHighlights和SendAllEndOfFrameUpdates（渲染代理在这里重建），
+ * 对比两种后端在游戏线程上的平均耗时
+ * 不需要视口，可以在-nullrhi下运行；GPU开销（Custom Depth通道和全屏后期）不在统计范围内
+ * 不指定EnemyClassPath时使用AAuraEnemy（没有网格资源），应传入带网格的敌人蓝图类
+ * 没有设置HighlightOverlayMaterial时使用引擎默认材质作为叠加材质
+ */
+static void RunHighlightBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+    UAuraHighlightSubsystem* HighlightSubsystem = World ? World->GetSubsystem<UAuraHighlightSubsystem>() : nullptr;
+    if (!HighlightSubsystem)
+    {
+        UE_LOG(LogAura, Warning, TEXT("aura.Benchmark.Highlight: 需要一个游戏世界"));
+        return;
+    }
+
+    const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+    UClass* EnemyClass = AAuraEnemy::StaticClass();
+    if (Args.Num() > 1)
+    {
+        EnemyClass = LoadClass<AAuraEnemy>(nullptr, *Args[1]);
+        if (!EnemyClass)
+        {
+            UE_LOG(LogAura, Warning, TEXT("aura.Benchmark.Highlight: 无法加载敌人类 %s"), *Args[1]);
+            return;
+        }
+    }
+
+    UMaterialInterface* OverlayMaterial = GetDefault<UAuraDeveloperSettings>()->HighlightOverlayMaterial.LoadSynchronous();
+    if (!OverlayMaterial)
+    {
+        OverlayMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
+    }
+
+    // 先提交之前挂起的请求，基准测试结束后恢复原来的后端
+    HighlightSubsystem->FlushHighlights();
+    const EAuraHighlightBackend OriginalBackend = HighlightSubsystem->GetHighlightBackend();
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    const EAuraHighlightBackend Backends[] = { EAuraHighlightBackend::CustomDepth, EAuraHighlightBackend::OverlayMaterial };
+    const int32 EnemyCounts[] = { 10, 100, 1000 };
+    for (const int32 EnemyCount : EnemyCounts)
+    {
+        // 在世界原点附近按正方形网格摆放敌人
+        const int32 Side = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(EnemyCount)));
+        TArray<AActor*> SpawnedEnemies;
+        TArray<IHighlightInterface*> Highlightables;
+        SpawnedEnemies.Reserve(EnemyCount);
+        Highlightables.Reserve(EnemyCount);
+        for (int32 Index = 0; Index < EnemyCount; ++Index)
+        {
+            const FVector Location((Index / Side - Side / 2) * 150.f, (Index % Side - Side / 2) * 150.f, 0.f);
+            if (AActor* Enemy = World->SpawnActor<AActor>(EnemyClass, Location, FRotator::ZeroRotator, SpawnParams))
+            {
+                SpawnedEnemies.Add(Enemy);
+                Highlightables.Add(Cast<IHighlightInterface>(Enemy));
+            }
+        }
+
+        double BackendMs[UE_ARRAY_COUNT(Backends)] = {};
+        for (int32 BackendIndex = 0; BackendIndex < UE_ARRAY_COUNT(Backends); ++BackendIndex)
+        {
+            HighlightSubsystem->SetHighlightBackend(Backends[BackendIndex], OverlayMaterial);
+
+            const double StartTime = FPlatformTime::Seconds();
+            for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+            {
+                for (IHighlightInterface* Highlightable : Highlightables)
+                {
+                    Highlightable->HighlightActor();
+                }
+                HighlightSubsystem->FlushHighlights();
+                World->SendAllEndOfFrameUpdates();
+
+                for (IHighlightInterface* Highlightable : Highlightables)
+                {
+                    Highlightable->UnHighlightActor();
+                }
+                HighlightSubsystem->FlushHighlights();
+                World->SendAllEndOfFrameUpdates();
+            }
+            BackendMs[BackendIndex] = (FPlatformTime::Seconds() - StartTime) * 1000.0 / Iterations;
+        }
+
+        UE_LOG(LogAura, Display,
+            TEXT("Highlight 敌人=%d: CustomDepth %.4f ms/次，OverlayMaterial %.4f ms/次（每次 = 全部高亮 + 全部取消高亮）"),
+            SpawnedEnemies.Num(), BackendMs[0], BackendMs[1]);
+
+        for (AActor* Enemy : SpawnedEnemies)
+        {
+            Enemy->Destroy();
+        }
+    }
+
+    HighlightSubsystem->SetHighlightBackend(OriginalBackend);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs AuraHighlightBenchmarkCommand(
+    TEXT("aura.Benchmark.Highlight"),
+    TEXT("对比CustomDepth与OverlayMaterial两种高亮后端在10/100/1000个敌人下的CPU耗时。用法：aura.Benchmark.Highlight [Iterations] [EnemyClassPath]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunHighlightBenchmark));
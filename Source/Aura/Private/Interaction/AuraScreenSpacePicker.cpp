@@ -0,0 +1,280 @@
+// Copyright Amor
+
+
+#include "Interaction/AuraScreenSpacePicker.h"
+#include "Interaction/AuraEnemyRegistry.h"
+#include "Character/AuraEnemy.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+
+#include "Aura/Aura.h"
+
+/**
+ * Rebuild 函数
+ * 将候选Actor的包围盒投影到屏幕空间，并写入均匀网格
+ */
+void FAuraScreenSpacePicker::Rebuild(const FMatrix& ViewProjection, const FIntRect& ViewRect, TConstArrayView<TWeakObjectPtr<AActor>> Candidates)
+{
+    Entries.Reset();
+    CellEntries.Reset();
+    GridViewRect = ViewRect;
+
+    const FIntPoint ViewSize = ViewRect.Size();
+    if (ViewSize.X <= 0 || ViewSize.Y <= 0)
+    {
+        GridSize = FIntPoint::ZeroValue;
+        CellStart.Reset();
+        return;
+    }
+
+    GridSize = FIntPoint(
+        FMath::DivideAndRoundUp(ViewSize.X, static_cast<int32>(CellSize)),
+        FMath::DivideAndRoundUp(ViewSize.Y, static_cast<int32>(CellSize)));
+
+    /**
+     * 第一步：投影
+     * 使用根组件缓存的包围盒（角色的根组件是胶囊体），不需要遍历所有组件
+     * 8个角点变换到裁剪空间后取屏幕矩形，任意角点在摄像机后方时跳过该Actor
+     */
+    for (const TWeakObjectPtr<AActor>& Candidate : Candidates)
+    {
+        AActor* Actor = Candidate.Get();
+        if (!Actor || Actor->IsHidden()) continue;
+
+        const USceneComponent* RootComponent = Actor->GetRootComponent();
+        if (!RootComponent) continue;
+
+        const FBox Bounds = RootComponent->Bounds.GetBox();
+        FVector Corners[8];
+        Bounds.GetVertices(Corners);
+
+        FBox2D ScreenRect(ForceInit);
+        bool bBehindCamera = false;
+        for (const FVector& Corner : Corners)
+        {
+            const FVector4 ClipPosition = ViewProjection.TransformFVector4(FVector4(Corner, 1.f));
+            if (ClipPosition.W <= UE_KINDA_SMALL_NUMBER)
+            {
+                bBehindCamera = true;
+                break;
+            }
+
+            // 裁剪空间 → NDC → 像素坐标（屏幕Y轴向下）
+            const double InvW = 1.0 / ClipPosition.W;
+            ScreenRect += FVector2D(
+                ViewRect.Min.X + (0.5 + ClipPosition.X * InvW * 0.5) * ViewSize.X,
+                ViewRect.Min.Y + (0.5 - ClipPosition.Y * InvW * 0.5) * ViewSize.Y);
+        }
+        if (bBehindCamera) continue;
+
+        // 完全在视图外的矩形不需要进入网格
+        if (ScreenRect.Max.X < ViewRect.Min.X || ScreenRect.Min.X > ViewRect.Max.X ||
+            ScreenRect.Max.Y < ViewRect.Min.Y || ScreenRect.Min.Y > ViewRect.Max.Y)
+        {
+            continue;
+        }
+
+        // 透视投影下裁剪空间的W就是视图空间深度
+        const FVector4 CenterClipPosition = ViewProjection.TransformFVector4(FVector4(Bounds.GetCenter(), 1.f));
+
+        FEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Rect = ScreenRect;
+        Entry.Depth = static_cast<float>(CenterClipPosition.W);
+        Entry.Actor = Actor;
+    }
+
+    /**
+     * 第二步：写入网格（CSR布局）
+     * 先统计每个格子中的矩形数量，前缀和得到每个格子的起始位置，再填充索引
+     */
+    const int32 NumCells = GridSize.X * GridSize.Y;
+    CellStart.Reset();
+    CellStart.SetNumZeroed(NumCells + 1);
+
+    auto GetCellRange = [this](const FBox2D& Rect, FIntPoint& OutMin, FIntPoint& OutMax)
+    {
+        OutMin.X = FMath::Clamp(FMath::FloorToInt32((Rect.Min.X - GridViewRect.Min.X) / CellSize), 0, GridSize.X - 1);
+        OutMin.Y = FMath::Clamp(FMath::FloorToInt32((Rect.Min.Y - GridViewRect.Min.Y) / CellSize), 0, GridSize.Y - 1);
+        OutMax.X = FMath::Clamp(FMath::FloorToInt32((Rect.Max.X - GridViewRect.Min.X) / CellSize), 0, GridSize.X - 1);
+        OutMax.Y = FMath::Clamp(FMath::FloorToInt32((Rect.Max.Y - GridViewRect.Min.Y) / CellSize), 0, GridSize.Y - 1);
+    };
+
+    for (const FEntry& Entry : Entries)
+    {
+        FIntPoint CellMin, CellMax;
+        GetCellRange(Entry.Rect, CellMin, CellMax);
+        for (int32 Y = CellMin.Y; Y <= CellMax.Y; ++Y)
+        {
+            for (int32 X = CellMin.X; X <= CellMax.X; ++X)
+            {
+                ++CellStart[Y * GridSize.X + X + 1];
+            }
+        }
+    }
+
+    for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+    {
+        CellStart[CellIndex + 1] += CellStart[CellIndex];
+    }
+
+    CellEntries.SetNumUninitialized(CellStart[NumCells]);
+    CellWriteCursor.Reset();
+    CellWriteCursor.Append(CellStart.GetData(), NumCells);
+
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+    {
+        FIntPoint CellMin, CellMax;
+        GetCellRange(Entries[EntryIndex].Rect, CellMin, CellMax);
+        for (int32 Y = CellMin.Y; Y <= CellMax.Y; ++Y)
+        {
+            for (int32 X = CellMin.X; X <= CellMax.X; ++X)
+            {
+                CellEntries[CellWriteCursor[Y * GridSize.X + X]++] = EntryIndex;
+            }
+        }
+    }
+}
+
+/**
+ * Pick 函数
+ * 只测试光标所在格子中的矩形，按深度选出离摄像机最近的Actor
+ */
+AActor* FAuraScreenSpacePicker::Pick(const FVector2D& ScreenPosition) const
+{
+    const int32 CellIndex = GetCellIndex(ScreenPosition);
+    if (CellIndex == INDEX_NONE) return nullptr;
+
+    AActor* BestActor = nullptr;
+    float BestDepth = TNumericLimits<float>::Max();
+    for (int32 Index = CellStart[CellIndex]; Index < CellStart[CellIndex + 1]; ++Index)
+    {
+        const FEntry& Entry = Entries[CellEntries[Index]];
+        if (Entry.Depth >= BestDepth || !Entry.Rect.IsInside(ScreenPosition)) continue;
+
+        if (AActor* Actor = Entry.Actor.Get())
+        {
+            BestActor = Actor;
+            BestDepth = Entry.Depth;
+        }
+    }
+    return BestActor;
+}
+
+int32 FAuraScreenSpacePicker::GetCellIndex(const FVector2D& ScreenPosition) const
+{
+    if (GridSize.X <= 0 || GridSize.Y <= 0) return INDEX_NONE;
+
+    const int32 X = FMath::FloorToInt32((ScreenPosition.X - GridViewRect.Min.X) / CellSize);
+    const int32 Y = FMath::FloorToInt32((ScreenPosition.Y - GridViewRect.Min.Y) / CellSize);
+    if (X < 0 || Y < 0 || X >= GridSize.X || Y >= GridSize.Y) return INDEX_NONE;
+
+    return Y * GridSize.X + X;
+}
+
+/**
+ * 光标拾取基准测试
+ * 用法：aura.Benchmark.CursorPicking [Iterations] [EnemyClassPath]
+ *
+ * 在摄像机前方分别生成10、100、1000个敌人，从屏幕中心发射光标射线，
+ * 对比物理射线检测（ECC_Target）与屏幕空间拾取（每次迭代都包含一次完整重建）的平均耗时
+ * 不指定EnemyClassPath时使用AAuraEnemy（只有胶囊体和悬停代理，没有网格）
+ */
+static void RunCursorPickingBenchmark(const TArray<FString>& Args, UWorld* World)
+{
+    APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+    const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+    UAuraEnemyRegistry* EnemyRegistry = World ? World->GetSubsystem<UAuraEnemyRegistry>() : nullptr;
+    if (!LocalPlayer || !LocalPlayer->ViewportClient || !EnemyRegistry)
+    {
+        UE_LOG(LogAura, Warning, TEXT("aura.Benchmark.CursorPicking: 需要一个带视口的本地玩家"));
+        return;
+    }
+
+    const int32 Iterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 200;
+    UClass* EnemyClass = AAuraEnemy::StaticClass();
+    if (Args.Num() > 1)
+    {
+        EnemyClass = LoadClass<AAuraEnemy>(nullptr, *Args[1]);
+        if (!EnemyClass)
+        {
+            UE_LOG(LogAura, Warning, TEXT("aura.Benchmark.CursorPicking: 无法加载敌人类 %s"), *Args[1]);
+            return;
+        }
+    }
+
+    FSceneViewProjectionData ProjectionData;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData)) return;
+    const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+    const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+
+    // 光标固定在屏幕中心，物理射线与屏幕空间拾取使用同一条光标射线
+    const FVector2D ScreenCenter = FVector2D(ViewRect.Min) + FVector2D(ViewRect.Size()) * 0.5;
+    FVector RayOrigin;
+    FVector RayDirection;
+    FSceneView::DeprojectScreenToWorld(ScreenCenter, ViewRect, ViewProjection.Inverse(), RayOrigin, RayDirection);
+    const FVector RayEnd = RayOrigin + RayDirection * PlayerController->HitResultTraceDistance;
+
+    const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AuraCursorPickingBenchmark), false);
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    const int32 EnemyCounts[] = { 10, 100, 1000 };
+    for (const int32 EnemyCount : EnemyCounts)
+    {
+        // 以光标射线前方1500单位处为中心，按正方形网格摆放敌人
+        const FVector GridCenter = RayOrigin + RayDirection * 1500.f;
+        const int32 Side = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(EnemyCount)));
+        TArray<AActor*> SpawnedEnemies;
+        SpawnedEnemies.Reserve(EnemyCount);
+        for (int32 Index = 0; Index < EnemyCount; ++Index)
+        {
+            const FVector Offset((Index / Side - Side / 2) * 150.f, (Index % Side - Side / 2) * 150.f, 0.f);
+            if (AActor* Enemy = World->SpawnActor<AActor>(EnemyClass, GridCenter + Offset, FRotator::ZeroRotator, SpawnParams))
+            {
+                SpawnedEnemies.Add(Enemy);
+            }
+        }
+
+        int32 PhysicsHits = 0;
+        const double PhysicsStartTime = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            FHitResult Hit;
+            if (World->LineTraceSingleByChannel(Hit, RayOrigin, RayEnd, ECC_Target, QueryParams))
+            {
+                ++PhysicsHits;
+            }
+        }
+        const double PhysicsMs = (FPlatformTime::Seconds() - PhysicsStartTime) * 1000.0 / Iterations;
+
+        FAuraScreenSpacePicker Picker;
+        int32 ScreenSpaceHits = 0;
+        const double ScreenSpaceStartTime = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            Picker.Rebuild(ViewProjection, ViewRect, EnemyRegistry->GetEnemies());
+            if (Picker.Pick(ScreenCenter))
+            {
+                ++ScreenSpaceHits;
+            }
+        }
+        const double ScreenSpaceMs = (FPlatformTime::Seconds() - ScreenSpaceStartTime) * 1000.0 / Iterations;
+
+        UE_LOG(LogAura, Display,
+            TEXT("CursorPicking 敌人=%d（注册表中共%d，屏幕上%d）: 物理射线 %.4f ms/次（命中%d），屏幕空间 %.4f ms/次（命中%d）"),
+            EnemyCount, EnemyRegistry->GetEnemies().Num(), Picker.GetNumEntries(),
+            PhysicsMs, PhysicsHits, ScreenSpaceMs, ScreenSpaceHits);
+
+        for (AActor* Enemy : SpawnedEnemies)
+        {
+            Enemy->Destroy();
+        }
+    }
+}
+
+static FAutoConsoleCommandWithWorldAndArgs AuraCursorPickingBenchmarkCommand(
+    TEXT("aura.Benchmark.CursorPicking"),
+    TEXT("对比物理射线与屏幕空间拾取在10/100/1000个敌人下的耗时。用法：aura.Benchmark.CursorPicking [Iterations] [EnemyClassPath]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunCursorPickingBenchmark));
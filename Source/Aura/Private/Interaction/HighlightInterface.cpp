@@ -0,0 +1,6 @@
+// Copyright Amor
+
+
+#include "Interaction/HighlightInterface.h"
+
+// Add default functionality here for any IHighlightInterface functions that are not pure virtual.
@@ -0,0 +1,306 @@
+// Copyright Amor
+
+
+#include "Player/AuraCursorHitSubsystem.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+
+/**
+ * 光标射线检测模式控制台变量
+ * 0: 同步检测，读取时在游戏线程上立即执行LineTraceSingleByChannel（阻塞）
+ * 1: 异步检测，读取时提交AsyncLineTraceByChannel，下一帧使用结果（默认）
+ * 可在运行时通过控制台切换，便于在Insights中对比两种方式的开销
+ */
+static TAutoConsoleVariable<int32> CVarAuraAsyncCursorTrace(
+    TEXT("aura.CursorTrace.Async"),
+    1,
+    TEXT("光标射线检测模式：0 = 同步检测，1 = 异步AsyncLineTraceByChannel（结果延迟一帧）"),
+    ECVF_Default);
+
+/**
+ * 悬停缓存开关
+ * 1: 光标位置、视图投影矩阵和命中Actor都未变化时跳过光标检测（默认）
+ * 0: 每帧都执行光标检测
+ */
+static TAutoConsoleVariable<int32> CVarAuraCursorTraceCache(
+    TEXT("aura.CursorTrace.Cache"),
+    1,
+    TEXT("光标悬停缓存：1 = 光标与视图未变化时跳过检测，0 = 每帧检测"),
+    ECVF_Default);
+
+/**
+ * 悬停缓存的最长有效期（秒）
+ * 即使光标和视图都没有变化，超过该时间也会重新检测一次
+ * 用于发现移动到光标下方的其他Actor（例如走进光标位置的敌人）
+ */
+static TAutoConsoleVariable<float> CVarAuraCursorTraceCacheMaxAge(
+    TEXT("aura.CursorTrace.CacheMaxAge"),
+    0.2f,
+    TEXT("悬停缓存的最长有效期（秒），超时后强制重新检测"),
+    ECVF_Default);
+
+/**
+ * 光标检测统计
+ * 使用"stat AuraCursor"查看发起/跳过的检测次数以及跳过比例（所有通道合计）
+ */
+DECLARE_STATS_GROUP(TEXT("AuraCursor"), STATGROUP_AuraCursor, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cursor Traces Issued"), STAT_AuraCursorTracesIssued, STATGROUP_AuraCursor);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Cursor Traces Skipped"), STAT_AuraCursorTracesSkipped, STATGROUP_AuraCursor);
+DECLARE_FLOAT_ACCUMULATOR_STAT(TEXT("Cursor Trace Skip Ratio"), STAT_AuraCursorTraceSkipRatio, STATGROUP_AuraCursor);
+
+// 跳过比例的统计窗口长度（次），每个窗口结束时刷新一次比例
+static constexpr uint32 CursorTraceStatWindowSize = 120;
+
+void UAuraCursorHitSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    // 委托只绑定一次，每次提交异步检测时传入它的地址即可
+    AsyncTraceDelegate.BindUObject(this, &UAuraCursorHitSubsystem::OnAsyncTraceCompleted);
+}
+
+/**
+ * GetCursorHit 函数
+ * 每帧每通道最多检测一次，读取次数不影响检测开销
+ */
+const FHitResult& UAuraCursorHitSubsystem::GetCursorHit(ECollisionChannel TraceChannel)
+{
+    FChannelState& State = Channels[TraceChannel];
+
+    // 本帧已经更新过该通道，直接共享结果
+    if (State.FrameNumber == GFrameCounter) return State.Hit;
+    State.FrameNumber = GFrameCounter;
+
+    const FCursorView& View = UpdateCursorView();
+    UWorld* World = GetLocalPlayer()->GetWorld();
+    const APlayerController* PlayerController = World ? GetLocalPlayer()->GetPlayerController(World) : nullptr;
+
+    // 光标不在视口内：没有可用的光标射线，清空结果并丢弃等待中的异步检测
+    if (!View.bValid || !PlayerController)
+    {
+        State.PendingTrace = FTraceHandle();
+        State.bCacheValid = false;
+        SetChannelHit(State, FHitResult());
+        return State.Hit;
+    }
+
+    /**
+     * 悬停缓存：光标和视图都没有变化、上次命中的Actor也没有移动时，
+     * 上一次的检测结果仍然有效，直接跳过本帧检测
+     */
+    if (CanSkipTrace(State, View))
+    {
+        RecordTraceStat(true);
+        return State.Hit;
+    }
+    RecordTraceStat(false);
+
+    // 记录本次检测的缓存键，供后续帧比较
+    State.bCacheValid = true;
+    State.CachedCursorPosition = View.CursorPosition;
+    State.CachedViewProjection = View.ViewProjection;
+    State.CachedTraceTime = World->GetTimeSeconds();
+
+    // 射线长度沿用APlayerController::HitResultTraceDistance，与GetHitResultUnderCursor一致
+    const FVector TraceEnd = View.RayOrigin + View.RayDirection * PlayerController->HitResultTraceDistance;
+
+    // 与GetHitResultUnderCursor一致：不使用复杂碰撞
+    const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AuraCursorTrace), false);
+
+    if (CVarAuraAsyncCursorTrace.GetValueOnGameThread() != 0)
+    {
+        /**
+         * 提交异步射线检测
+         * EAsyncTraceType::Single: 只需要第一个阻挡命中
+         * 检测结果会在下一帧通过AsyncTraceDelegate回调写入该通道，本帧先返回上一次的结果
+         * 记录句柄，过期（被新请求替换）的检测结果会在回调中被忽略
+         */
+        State.PendingTrace = World->AsyncLineTraceByChannel(
+            EAsyncTraceType::Single,
+            View.RayOrigin,
+            TraceEnd,
+            TraceChannel,
+            QueryParams,
+            FCollisionResponseParams::DefaultResponseParam,
+            &AsyncTraceDelegate);
+        return State.Hit;
+    }
+
+    // 同步模式：丢弃仍在等待的异步结果，避免同一通道被写入两次
+    State.PendingTrace = FTraceHandle();
+
+    FHitResult Hit;
+    World->LineTraceSingleByChannel(Hit, View.RayOrigin, TraceEnd, TraceChannel, QueryParams);
+    SetChannelHit(State, Hit);
+    return State.Hit;
+}
+
+bool UAuraCursorHitSubsystem::GetCursorRay(FVector& OutOrigin, FVector& OutDirection)
+{
+    const FCursorView& View = UpdateCursorView();
+    OutOrigin = View.RayOrigin;
+    OutDirection = View.RayDirection;
+    return View.bValid;
+}
+
+bool UAuraCursorHitSubsystem::GetCursorView(FVector2D& OutCursorPosition, FMatrix& OutViewProjection, FIntRect& OutViewRect)
+{
+    const FCursorView& View = UpdateCursorView();
+    OutCursorPosition = View.CursorPosition;
+    OutViewProjection = View.ViewProjection;
+    OutViewRect = View.ViewRect;
+    return View.bValid;
+}
+
+/**
+ * SetCursorPositionOverride 函数
+ * 覆盖值参与悬停缓存判断的方式与真实鼠标坐标完全相同
+ */
+void UAuraCursorHitSubsystem::SetCursorPositionOverride(const TOptional<FVector2D>& CursorPosition)
+{
+    bOverrideCursorPosition = true;
+    CursorPositionOverride = CursorPosition;
+}
+
+void UAuraCursorHitSubsystem::ClearCursorPositionOverride()
+{
+    bOverrideCursorPosition = false;
+    CursorPositionOverride.Reset();
+}
+
+/**
+ * UpdateCursorView 函数
+ * 计算光标像素坐标、视图投影矩阵和光标射线，每帧只计算一次
+ * 视图投影矩阵同时包含摄像机位置、朝向和投影参数，任何一项变化都会使悬停缓存失效
+ */
+const UAuraCursorHitSubsystem::FCursorView& UAuraCursorHitSubsystem::UpdateCursorView()
+{
+    if (CursorView.FrameNumber == GFrameCounter) return CursorView;
+    CursorView.FrameNumber = GFrameCounter;
+    CursorView.bValid = false;
+
+    const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+    UWorld* World = LocalPlayer->GetWorld();
+    const APlayerController* PlayerController = World ? LocalPlayer->GetPlayerController(World) : nullptr;
+    if (!PlayerController || !LocalPlayer->ViewportClient) return CursorView;
+
+    float MouseX = 0.f;
+    float MouseY = 0.f;
+    if (bOverrideCursorPosition)
+    {
+        if (!CursorPositionOverride.IsSet()) return CursorView;
+        MouseX = CursorPositionOverride->X;
+        MouseY = CursorPositionOverride->Y;
+    }
+    else if (!PlayerController->GetMousePosition(MouseX, MouseY))
+    {
+        return CursorView;
+    }
+
+    FSceneViewProjectionData ProjectionData;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData)) return CursorView;
+
+    CursorView.CursorPosition = FVector2D(MouseX, MouseY);
+    CursorView.ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+    CursorView.ViewRect = ProjectionData.GetConstrainedViewRect();
+
+    // 与APlayerController::DeprojectScreenPositionToWorld相同的反投影，得到光标射线
+    FSceneView::DeprojectScreenToWorld(
+        CursorView.CursorPosition,
+        CursorView.ViewRect,
+        CursorView.ViewProjection.Inverse(),
+        CursorView.RayOrigin,
+        CursorView.RayDirection);
+
+    CursorView.bValid = true;
+    return CursorView;
+}
+
+/**
+ * CanSkipTrace 函数
+ * 判断某个通道上一次的检测结果是否仍然有效
+ */
+bool UAuraCursorHitSubsystem::CanSkipTrace(const FChannelState& State, const FCursorView& View) const
+{
+    if (CVarAuraCursorTraceCache.GetValueOnGameThread() == 0 || !State.bCacheValid) return false;
+
+    // 光标移动（允许亚像素误差）或摄像机/投影变化，必须重新检测
+    if (!View.CursorPosition.Equals(State.CachedCursorPosition, 0.5)) return false;
+    if (!View.ViewProjection.Equals(State.CachedViewProjection, UE_KINDA_SMALL_NUMBER)) return false;
+
+    // 缓存超过最长有效期，重新检测以发现移动到光标下方的其他Actor
+    const double CacheAge = GetLocalPlayer()->GetWorld()->GetTimeSeconds() - State.CachedTraceTime;
+    if (CacheAge > CVarAuraCursorTraceCacheMaxAge.GetValueOnGameThread()) return false;
+
+    /**
+     * 世界"变脏"信号：上次命中的Actor被销毁或者发生了移动
+     * IsStale(): 弱指针曾经指向对象但对象已被销毁
+     */
+    if (State.CachedHitActor.IsStale()) return false;
+    if (const AActor* HitActor = State.CachedHitActor.Get())
+    {
+        if (!HitActor->GetActorTransform().Equals(State.CachedHitActorTransform)) return false;
+    }
+
+    return true;
+}
+
+void UAuraCursorHitSubsystem::SetChannelHit(FChannelState& State, const FHitResult& Hit)
+{
+    State.Hit = Hit;
+
+    // 记录本次命中的Actor及其变换，作为悬停缓存的"世界变脏"判断依据
+    State.CachedHitActor = Hit.GetActor();
+    if (const AActor* HitActor = State.CachedHitActor.Get())
+    {
+        State.CachedHitActorTransform = HitActor->GetActorTransform();
+    }
+}
+
+/**
+ * OnAsyncTraceCompleted 函数
+ * 异步检测完成回调，在下一帧的游戏线程上、Actor Tick之前调用
+ */
+void UAuraCursorHitSubsystem::OnAsyncTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+    if (TraceDatum.TraceChannel >= ECC_MAX) return;
+
+    FChannelState& State = Channels[TraceDatum.TraceChannel];
+
+    // 只处理该通道最近一次提交的检测，忽略已经过期的结果
+    if (TraceHandle != State.PendingTrace) return;
+    State.PendingTrace = FTraceHandle();
+
+    // Single类型的检测最多返回一个阻挡命中，没有命中时使用默认的FHitResult（bBlockingHit为false）
+    SetChannelHit(State, TraceDatum.OutHits.Num() > 0 ? TraceDatum.OutHits[0] : FHitResult());
+}
+
+/**
+ * RecordTraceStat 函数
+ * 累计发起/跳过的检测次数，每个统计窗口结束时刷新跳过比例，
+ * 便于对比空闲和战斗场景下悬停缓存的收益
+ */
+void UAuraCursorHitSubsystem::RecordTraceStat(bool bSkipped)
+{
+    if (bSkipped)
+    {
+        INC_DWORD_STAT(STAT_AuraCursorTracesSkipped);
+        ++TracesSkippedInWindow;
+    }
+    else
+    {
+        INC_DWORD_STAT(STAT_AuraCursorTracesIssued);
+        ++TracesIssuedInWindow;
+    }
+
+    const uint32 WindowTotal = TracesIssuedInWindow + TracesSkippedInWindow;
+    if (WindowTotal >= CursorTraceStatWindowSize)
+    {
+        SET_FLOAT_STAT(STAT_AuraCursorTraceSkipRatio, static_cast<float>(TracesSkippedInWindow) / WindowTotal);
+        TracesIssuedInWindow = 0;
+        TracesSkippedInWindow = 0;
+    }
+}
@@ -0,0 +1,248 @@
+// Copyright Amor
+
+#include "Player/AuraInputRecorder.h"
+#include "Misc/App.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#include "Aura/Aura.h"
+
+namespace AuraInputRecorder
+{
+    /** 文件标识 "AIRC" */
+    constexpr uint32 FileMagic = 0x43524941;
+
+    /** 文件格式版本，格式变化时递增 */
+    constexpr uint32 FileVersion = 2;
+
+    /** 每帧的字段标记 */
+    constexpr uint8 FlagMoveInput = 1 << 0;
+    constexpr uint8 FlagCursorPosition = 1 << 1;
+    constexpr uint8 FlagClickMove = 1 << 2;
+}
+
+FString FAuraInputRecorder::GetRecordingFilePath(const FString& Name)
+{
+    return FPaths::Combine(FPaths::ProfilingDir(), TEXT("InputRecordings"), Name + TEXT(".airec"));
+}
+
+/**
+ * StartRecording 函数
+ * 录制与回放互斥，开始录制会中止正在进行的回放
+ */
+void FAuraInputRecorder::StartRecording(const FString& Name)
+{
+    StopReplay();
+
+    Mode = EMode::Recording;
+    RecordingName = Name;
+    StartTime = FPlatformTime::Seconds();
+    Frames.Reset();
+
+    UE_LOG(LogAura, Log, TEXT("开始录制输入 '%s'"), *RecordingName);
+}
+
+void FAuraInputRecorder::RecordFrame(const TOptional<FVector2D>& MoveInput, const TOptional<FVector2D>& CursorPosition, bool bClickMove)
+{
+    if (Mode != EMode::Recording) return;
+
+    FAuraRecordedInputFrame& Frame = Frames.AddDefaulted_GetRef();
+    Frame.Time = static_cast<float>(FPlatformTime::Seconds() - StartTime);
+    Frame.bHasMoveInput = MoveInput.IsSet();
+    Frame.bHasCursorPosition = CursorPosition.IsSet();
+    Frame.bClickMove = bClickMove;
+    if (MoveInput.IsSet())
+    {
+        Frame.MoveInput = FVector2f(MoveInput.GetValue());
+    }
+    if (CursorPosition.IsSet())
+    {
+        Frame.CursorPosition = FVector2f(CursorPosition.GetValue());
+    }
+}
+
+/**
+ * StopRecording 函数
+ * 先序列化到内存，再一次性写入文件
+ */
+bool FAuraInputRecorder::StopRecording()
+{
+    if (Mode != EMode::Recording) return false;
+    Mode = EMode::Idle;
+
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    SerializeFrames(Writer, Frames);
+
+    const FString FilePath = GetRecordingFilePath(RecordingName);
+    if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+    {
+        UE_LOG(LogAura, Error, TEXT("输入录制写入失败：%s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogAura, Log, TEXT("输入录制 '%s' 已保存：%d 帧，%.2f 秒，%d 字节 -> %s"),
+        *RecordingName, Frames.Num(), Frames.Num() > 0 ? Frames.Last().Time : 0.f, Bytes.Num(), *FilePath);
+    return true;
+}
+
+/**
+ * StartReplay 函数
+ * 读取并校验录制文件，成功后从第一帧开始回放
+ *
+ * 固定时间步长：
+ * 回放期间每帧的DeltaTime固定为录制时的平均帧时间，不随回放时的实际帧率变化，
+ * 每条移动输入在回放中作用的时间与录制时相同，角色走过的路径一致，不同版本之间的回放可以直接比较
+ * 引擎按固定步长推进游戏时间但不会等待，回放的真实耗时仍然反映帧时间
+ */
+bool FAuraInputRecorder::StartReplay(const FString& Name)
+{
+    const FString FilePath = GetRecordingFilePath(Name);
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+    {
+        UE_LOG(LogAura, Error, TEXT("找不到输入录制文件：%s"), *FilePath);
+        return false;
+    }
+
+    TArray<FAuraRecordedInputFrame> LoadedFrames;
+    FMemoryReader Reader(Bytes);
+    SerializeFrames(Reader, LoadedFrames);
+    if (Reader.IsError())
+    {
+        UE_LOG(LogAura, Error, TEXT("输入录制文件无效或版本不受支持：%s"), *FilePath);
+        return false;
+    }
+
+    Mode = EMode::Replaying;
+    RecordingName = Name;
+    Frames = MoveTemp(LoadedFrames);
+    ReplayIndex = 0;
+    StartTime = FPlatformTime::Seconds();
+
+    bPreviousUseFixedTimeStep = FApp::UseFixedTimeStep();
+    PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+    FApp::SetUseFixedTimeStep(true);
+    FApp::SetFixedDeltaTime(GetRecordedDeltaTime());
+
+    UE_LOG(LogAura, Log, TEXT("开始回放输入 '%s'：%d 帧，固定帧时间 %.3f 毫秒"),
+        *RecordingName, Frames.Num(), GetRecordedDeltaTime() * 1000.0);
+    return true;
+}
+
+const FAuraRecordedInputFrame* FAuraInputRecorder::NextReplayFrame()
+{
+    if (Mode != EMode::Replaying) return nullptr;
+
+    if (!Frames.IsValidIndex(ReplayIndex))
+    {
+        LogReplaySummary();
+        Mode = EMode::Idle;
+        RestoreTimeStep();
+        return nullptr;
+    }
+
+    return &Frames[ReplayIndex++];
+}
+
+void FAuraInputRecorder::StopReplay()
+{
+    if (Mode != EMode::Replaying) return;
+
+    UE_LOG(LogAura, Log, TEXT("输入回放 '%s' 在第 %d/%d 帧中止"), *RecordingName, ReplayIndex, Frames.Num());
+    Mode = EMode::Idle;
+    RestoreTimeStep();
+}
+
+/**
+ * GetRecordedDeltaTime 函数
+ * 第一帧的时间戳是录制开始后的第一次记录，平均帧时间按相邻两帧之间的间隔计算
+ * 帧数不足两帧时使用30帧每秒
+ */
+double FAuraInputRecorder::GetRecordedDeltaTime() const
+{
+    if (Frames.Num() < 2) return 1.0 / 30.0;
+
+    const double RecordedSpan = Frames.Last().Time - Frames[0].Time;
+    return RecordedSpan > 0.0 ? RecordedSpan / (Frames.Num() - 1) : 1.0 / 30.0;
+}
+
+void FAuraInputRecorder::RestoreTimeStep()
+{
+    FApp::SetUseFixedTimeStep(bPreviousUseFixedTimeStep);
+    FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+}
+
+/**
+ * SerializeFrames 函数
+ * 读写共用同一份代码，保证格式一致
+ * 读取时文件头不匹配或数据不完整会把归档标记为错误
+ */
+void FAuraInputRecorder::SerializeFrames(FArchive& Ar, TArray<FAuraRecordedInputFrame>& InOutFrames)
+{
+    uint32 Magic = AuraInputRecorder::FileMagic;
+    uint32 Version = AuraInputRecorder::FileVersion;
+    int32 NumFrames = InOutFrames.Num();
+    Ar << Magic << Version << NumFrames;
+
+    if (Magic != AuraInputRecorder::FileMagic || Version != AuraInputRecorder::FileVersion || NumFrames < 0)
+    {
+        Ar.SetError();
+        return;
+    }
+
+    if (Ar.IsLoading())
+    {
+        // 每帧至少5字节（时间+标记），防止损坏的文件请求过大的分配
+        if (NumFrames > Ar.TotalSize() / 5)
+        {
+            Ar.SetError();
+            return;
+        }
+        InOutFrames.SetNum(NumFrames);
+    }
+
+    for (FAuraRecordedInputFrame& Frame : InOutFrames)
+    {
+        uint8 Flags = (Frame.bHasMoveInput ? AuraInputRecorder::FlagMoveInput : 0)
+            | (Frame.bHasCursorPosition ? AuraInputRecorder::FlagCursorPosition : 0)
+            | (Frame.bClickMove ? AuraInputRecorder::FlagClickMove : 0);
+        Ar << Frame.Time << Flags;
+
+        Frame.bHasMoveInput = (Flags & AuraInputRecorder::FlagMoveInput) != 0;
+        Frame.bHasCursorPosition = (Flags & AuraInputRecorder::FlagCursorPosition) != 0;
+        Frame.bClickMove = (Flags & AuraInputRecorder::FlagClickMove) != 0;
+        if (Frame.bHasMoveInput)
+        {
+            Ar << Frame.MoveInput;
+        }
+        if (Frame.bHasCursorPosition)
+        {
+            Ar << Frame.CursorPosition;
+        }
+
+        if (Ar.IsError()) return;
+    }
+}
+
+/**
+ * LogReplaySummary 函数
+ * 回放按帧推进，游戏时间按固定步长推进，回放的真实耗时与录制耗时的差异直接反映两个版本的帧时间差异
+ */
+void FAuraInputRecorder::LogReplaySummary() const
+{
+    const double ReplaySeconds = FPlatformTime::Seconds() - StartTime;
+    const float RecordedSeconds = Frames.Num() > 0 ? Frames.Last().Time : 0.f;
+    const int32 NumFrames = FMath::Max(Frames.Num(), 1);
+
+    UE_LOG(LogAura, Log, TEXT("输入回放 '%s' 完成：%d 帧，录制 %.2f 秒（%.3f 毫秒/帧），回放 %.2f 秒（%.3f 毫秒/帧）"),
+        *RecordingName,
+        Frames.Num(),
+        RecordedSeconds,
+        RecordedSeconds * 1000.0 / NumFrames,
+        ReplaySeconds,
+        ReplaySeconds * 1000.0 / NumFrames);
+}
@@ -3,9 +3,18 @@
 #include "Player/AuraPlayerController.h"
 #include "EnhancedInputSubSystems.h"
 #include "EnhancedInputComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "Components/SplineComponent.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "Player/AuraCursorHitSubsystem.h"
 
 // 包含敌人接口定义，用于交互检测和敌人高亮功能
 #include "Interaction/EnemyInterface.h"
+#include "Interaction/AuraEnemyRegistry.h"
+#include "Character/AuraEnemy.h"
+
+#include "Aura/Aura.h"
 
 /**
  * AAuraPlayerController 构造函数
@@ -21,6 +30,8 @@ AAuraPlayerController::AAuraPlayerController()
      */
     bReplicates = true;
 
+    // 点击移动的路径缓存，只保存路径点，不参与渲染和碰撞
+    Spline = CreateDefaultSubobject<USplineComponent>(TEXT("Spline"));
 }
 
 /**
@@ -31,13 +42,191 @@ AAuraPlayerController::AAuraPlayerController()
  */
 void AAuraPlayerController::PlayerTick(float DeltaTime)
 {
+    // 输入回放必须在父类处理输入之前注入，点击移动等输入回调读取的光标坐标才是录制的坐标
+    UpdateInputReplay();
+
     // 调用父类的PlayerTick，确保基础更新逻辑正常执行
     // 父类可能处理了输入缓冲、摄像机更新等重要功能
     Super::PlayerTick(DeltaTime);
 
+    // 输入已处理完毕，本帧的移动输入已经累加完成
+    RecordInputFrame();
+
     // 每帧执行光标准踪，检测光标下的交互对象
     // 这确保玩家移动光标时能实时响应交互变化
     CursorTrace();
+
+    // 点击移动复用本帧的光标检测结果，必须在CursorTrace之后执行
+    ResolveClickMove();
+
+    // 悬停目标变化时（限速）上报服务器
+    UpdateServerHoverTarget();
+
+    // 范围选敌复用本帧的光标检测结果，必须在CursorTrace之后执行
+    if (bAreaTargetingActive)
+    {
+        UpdateAreaTargeting();
+    }
+
+    // 合并本帧所有的键盘移动事件，只提交一次移动输入
+    ApplyPendingMoveInput();
+
+    // 沿缓存的路径移动，不需要每帧重新寻路
+    AutoRun();
+}
+
+/**
+ * BeginAreaTargeting 函数
+ * 开始范围选敌预览，结果从下一次PlayerTick开始更新
+ */
+void AAuraPlayerController::BeginAreaTargeting(float Radius)
+{
+    bAreaTargetingActive = true;
+    AreaTargetingRadius = FMath::Max(0.f, Radius);
+}
+
+/**
+ * EndAreaTargeting 函数
+ * 结束范围选敌预览，取消所有范围目标的高亮（光标正悬停的敌人除外）
+ */
+void AAuraPlayerController::EndAreaTargeting()
+{
+    bAreaTargetingActive = false;
+
+    if (const UAuraEnemyRegistry* EnemyRegistry = GetEnemyRegistry())
+    {
+        for (const FAuraEnemyHandle& Target : AreaTargets)
+        {
+            IEnemyInterface* Enemy = EnemyRegistry->Resolve(Target);
+            if (Enemy && Target != ThisActor)
+            {
+                Enemy->UnHighlightActor();
+            }
+        }
+    }
+    AreaTargets.Reset();
+}
+
+/**
+ * UpdateAreaTargeting 函数
+ * 每帧一次球形重叠查询，代替对每个敌人单独调用接口检测距离
+ *
+ * 高亮更新只处理集合差：
+ * - 新集合中有、旧集合中没有的敌人：高亮
+ * - 旧集合中有、新集合中没有的敌人：取消高亮
+ * 停留在范围内的敌人不会重复调用HighlightActor
+ */
+void AAuraPlayerController::UpdateAreaTargeting()
+{
+    const UAuraEnemyRegistry* EnemyRegistry = GetEnemyRegistry();
+    if (!EnemyRegistry) return;
+
+    NewAreaTargets.Reset();
+
+    FVector Center;
+    if (GetAreaTargetingCenter(Center) && AreaTargetingRadius > 0.f)
+    {
+        /**
+         * 球形重叠查询ECC_Target通道
+         * 角色身上只有悬停代理响应该通道（胶囊体和网格忽略），查询结果中的场景几何由下面的注册表查找过滤掉
+         */
+        AreaOverlaps.Reset();
+        const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(AuraAreaTargeting), false);
+        GetWorld()->OverlapMultiByChannel(
+            AreaOverlaps,
+            Center,
+            FQuat::Identity,
+            ECC_Target,
+            FCollisionShape::MakeSphere(AreaTargetingRadius),
+            QueryParams);
+
+        // 只保留注册表中的敌人，查表代替逐个Cast<IEnemyInterface>
+        for (const FOverlapResult& Overlap : AreaOverlaps)
+        {
+            const FAuraEnemyHandle Handle = EnemyRegistry->FindHandle(Overlap.GetActor());
+            if (Handle.IsSet())
+            {
+                NewAreaTargets.AddUnique(Handle);
+            }
+        }
+    }
+
+    // 新进入范围的敌人：高亮
+    for (const FAuraEnemyHandle& Target : NewAreaTargets)
+    {
+        if (!AreaTargets.Contains(Target))
+        {
+            EnemyRegistry->Resolve(Target)->HighlightActor();
+        }
+    }
+
+    // 离开范围的敌人：取消高亮（光标仍悬停在它身上时保持高亮；已销毁的敌人解析为nullptr）
+    for (const FAuraEnemyHandle& Target : AreaTargets)
+    {
+        if (NewAreaTargets.Contains(Target)) continue;
+
+        IEnemyInterface* Enemy = EnemyRegistry->Resolve(Target);
+        if (Enemy && Target != ThisActor)
+        {
+            Enemy->UnHighlightActor();
+        }
+    }
+
+    Swap(AreaTargets, NewAreaTargets);
+}
+
+/**
+ * GetAreaTargetingCenter 函数
+ * 复用本帧CursorTrace的ECC_Target结果（与悬停和点击移动共享同一次检测，异步模式下三者看到的是同一帧），
+ * 没有命中时计算光标射线与角色脚下水平面的交点（俯视角游戏中地面近似为水平面）
+ */
+bool AAuraPlayerController::GetAreaTargetingCenter(FVector& OutCenter) const
+{
+    if (FrameCursorHit.bBlockingHit)
+    {
+        OutCenter = FrameCursorHit.ImpactPoint;
+        return true;
+    }
+
+    return GetCursorGroundPlanePoint(OutCenter);
+}
+
+/**
+ * GetCursorGroundPlanePoint 函数
+ * 地平面高度取角色胶囊体底部
+ */
+bool AAuraPlayerController::GetCursorGroundPlanePoint(FVector& OutPoint) const
+{
+    UAuraCursorHitSubsystem* CursorHitSubsystem = GetCursorHitSubsystem();
+    FVector CursorRayOrigin;
+    FVector CursorRayDirection;
+    const APawn* ControlledPawn = GetPawn();
+    if (!ControlledPawn || !CursorHitSubsystem || !CursorHitSubsystem->GetCursorRay(CursorRayOrigin, CursorRayDirection)) return false;
+
+    // 射线与地平面平行时没有交点
+    if (FMath::Abs(CursorRayDirection.Z) < UE_KINDA_SMALL_NUMBER) return false;
+
+    const double GroundZ = ControlledPawn->GetActorLocation().Z - ControlledPawn->GetSimpleCollisionHalfHeight();
+    const double RayDistance = (GroundZ - CursorRayOrigin.Z) / CursorRayDirection.Z;
+    if (RayDistance < 0.0) return false;
+
+    OutPoint = CursorRayOrigin + CursorRayDirection * RayDistance;
+    return true;
+}
+
+/**
+ * IsAreaTarget 函数
+ * 范围选敌结果通常只有几个到几十个敌人，线性比较句柄即可
+ */
+bool AAuraPlayerController::IsAreaTarget(const FAuraEnemyHandle& Enemy) const
+{
+    return Enemy.IsSet() && AreaTargets.Contains(Enemy);
+}
+
+UAuraEnemyRegistry* AAuraPlayerController::GetEnemyRegistry() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->GetSubsystem<UAuraEnemyRegistry>() : nullptr;
 }
 
 /**
@@ -123,6 +312,109 @@ void AAuraPlayerController::BeginPlay()
      * 输入模式决定了控制器如何处理不同类型的输入（游戏、UI等）
      */
     SetInputMode(InputModeData);
+
+    /**
+     * 命令行启动回放，用于无人值守的性能采集
+     * 例如：-AuraReplayInput=Benchmark01 -AuraReplayInputExit
+     */
+    FString ReplayName;
+    if (IsLocalController() && FParse::Value(FCommandLine::Get(), TEXT("AuraReplayInput="), ReplayName))
+    {
+        bExitAfterInputReplay = FParse::Param(FCommandLine::Get(), TEXT("AuraReplayInputExit"));
+        AuraReplayInput(ReplayName);
+    }
+}
+
+void AAuraPlayerController::AuraRecordInput(const FString& Name)
+{
+    AuraStopReplayInput();
+    InputRecorder.StartRecording(Name.IsEmpty() ? TEXT("Default") : Name);
+}
+
+void AAuraPlayerController::AuraStopRecordInput()
+{
+    InputRecorder.StopRecording();
+}
+
+/**
+ * AuraReplayInput 函数
+ * 回放开始时清空点击移动和已累加的输入，保证回放从相同的状态开始
+ */
+void AAuraPlayerController::AuraReplayInput(const FString& Name)
+{
+    InputRecorder.StopRecording();
+    if (!InputRecorder.StartReplay(Name.IsEmpty() ? TEXT("Default") : Name)) return;
+
+    StopAutoRun();
+    PendingMoveInput = FVector2D::ZeroVector;
+    bHasPendingMoveInput = false;
+    bClickMoveRequested = false;
+}
+
+void AAuraPlayerController::AuraStopReplayInput()
+{
+    if (!InputRecorder.IsReplaying()) return;
+
+    InputRecorder.StopReplay();
+    if (UAuraCursorHitSubsystem* CursorHitSubsystem = GetCursorHitSubsystem())
+    {
+        CursorHitSubsystem->ClearCursorPositionOverride();
+    }
+}
+
+/**
+ * UpdateInputReplay 函数
+ * 每帧取出一条录制记录：光标坐标交给光标命中服务，移动输入直接作为本帧的累加输入，
+ * 点击移动与真实点击走同一条路径（ResolveClickMove在CursorTrace之后使用回放的光标坐标）
+ */
+void AAuraPlayerController::UpdateInputReplay()
+{
+    if (!InputRecorder.IsReplaying()) return;
+
+    UAuraCursorHitSubsystem* CursorHitSubsystem = GetCursorHitSubsystem();
+    const FAuraRecordedInputFrame* Frame = InputRecorder.NextReplayFrame();
+    if (!Frame)
+    {
+        // 回放结束，恢复真实光标
+        if (CursorHitSubsystem)
+        {
+            CursorHitSubsystem->ClearCursorPositionOverride();
+        }
+        if (bExitAfterInputReplay)
+        {
+            ConsoleCommand(TEXT("quit"));
+        }
+        return;
+    }
+
+    if (CursorHitSubsystem)
+    {
+        CursorHitSubsystem->SetCursorPositionOverride(Frame->bHasCursorPosition
+            ? TOptional<FVector2D>(FVector2D(Frame->CursorPosition))
+            : TOptional<FVector2D>());
+    }
+
+    PendingMoveInput = FVector2D(Frame->MoveInput);
+    bHasPendingMoveInput = Frame->bHasMoveInput;
+    bClickMoveRequested = Frame->bClickMove;
+}
+
+void AAuraPlayerController::RecordInputFrame()
+{
+    if (!InputRecorder.IsRecording()) return;
+
+    TOptional<FVector2D> CursorPosition;
+    float MouseX = 0.f;
+    float MouseY = 0.f;
+    if (GetMousePosition(MouseX, MouseY))
+    {
+        CursorPosition = FVector2D(MouseX, MouseY);
+    }
+
+    InputRecorder.RecordFrame(
+        bHasPendingMoveInput ? TOptional<FVector2D>(PendingMoveInput) : TOptional<FVector2D>(),
+        CursorPosition,
+        bClickMoveRequested);
 }
 
 /**
@@ -161,6 +453,16 @@ void AAuraPlayerController::SetupInputComponent()
         this,                           // 执行对象：当前控制器实例
         &AAuraPlayerController::Move    // 回调函数：当输入触发时调用的函数
     );
+
+    /**
+     * 绑定点击移动输入事件
+     * Triggered在按下的第一帧和按住期间每帧触发，按住拖动时目的地跟随光标
+     * 是否真正重新寻路由SetMoveDestination根据距离阈值决定
+     */
+    if (ClickMoveAction)
+    {
+        EnhancedInputComponent->BindAction(ClickMoveAction, ETriggerEvent::Triggered, this, &AAuraPlayerController::ClickMove);
+    }
     // 注意：可以在此处添加更多输入绑定，如攻击、技能、菜单等
 }
 
@@ -169,6 +471,10 @@ void AAuraPlayerController::SetupInputComponent()
  * 处理角色移动的输入回调，当移动输入被触发时调用
  * @param InputActionValue 输入动作的值，包含输入方向和强度信息
  * 对于2D移动输入，通常包含X（左右）和Y（前后）分量，值范围通常在-1到1之间
+ *
+ * 这里只累加输入值，不直接驱动Pawn
+ * 一帧内可能有多个设备或高回报率设备多次触发同一个动作，
+ * 所有事件在PlayerTick中由ApplyPendingMoveInput合并成一次移动输入
  */
 void AAuraPlayerController::Move(const FInputActionValue& InputActionValue)
 {
@@ -181,63 +487,209 @@ void AAuraPlayerController::Move(const FInputActionValue& InputActionValue)
      */
     const FVector2D InputAxisVector = InputActionValue.Get<FVector2D>();
 
-    /**
-     * 获取控制器的当前旋转（看向的方向）
-     * GetControlRotation()返回控制器的旋转角度（偏航Yaw、俯仰Pitch、翻滚Roll）
-     * 这对于计算基于摄像机方向的移动非常重要
-     */
-    const FRotator Rotation = GetControlRotation();
+    // 回放期间移动输入来自录制文件，忽略真实输入
+    if (InputRecorder.IsReplaying()) return;
+
+    // 键盘移动优先于点击移动，有键盘输入时取消自动移动
+    if (bHasMoveDestination)
+    {
+        StopAutoRun();
+    }
+
+    // 累加到本帧的输入中，与逐个调用AddMovementInput的效果相同（移动组件同样是累加）
+    PendingMoveInput += InputAxisVector;
+    bHasPendingMoveInput = true;
+}
+
+/**
+ * ApplyPendingMoveInput 函数
+ * 每帧最多执行一次：计算一次摄像机偏航基向量，提交一个合并后的移动向量
+ * 无论本帧收到多少个移动事件，开销都是固定的
+ */
+void AAuraPlayerController::ApplyPendingMoveInput()
+{
+    if (!bHasPendingMoveInput) return;
+
+    const FVector2D InputAxisVector = PendingMoveInput;
+    PendingMoveInput = FVector2D::ZeroVector;
+    bHasPendingMoveInput = false;
 
     /**
-     * 只使用Yaw（水平旋转）创建新的旋转，忽略Pitch（俯仰）和Roll（翻滚）
-     * 这确保了移动是相对于水平地面的，不会因为摄像机俯仰而向上/向下移动
-     * FRotator构造函数的参数顺序为：(Pitch, Yaw, Roll)
+     * 获取此控制器当前控制的Pawn（角色）
+     * 如果没有控制任何Pawn，则移动输入被忽略（可能在角色死亡或切换时发生）
      */
-    const FRotator YawRotation(0.f, Rotation.Yaw, 0.f);
+    APawn* ControlledPawn = GetPawn<APawn>();
+    if (!ControlledPawn) return;
 
     /**
-     * 根据YawRotation计算前向方向向量（前进/后退方向）
-     * FRotationMatrix：将旋转转换为矩阵，便于获取方向向量
-     * GetUnitAxis(EAxis::X)：获取X轴单位向量，在UE坐标系中通常是前向
+     * 只使用控制器旋转的Yaw（水平旋转），忽略Pitch（俯仰）和Roll（翻滚）
+     * 这确保了移动是相对于水平地面的，不会因为摄像机俯仰而向上/向下移动
+     * 前向和右向基向量来自同一个旋转矩阵，只构造一次
      * UE坐标系：X=前，Y=右，Z=上
      */
-    const FVector ForwardDirection = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::X);
+    const FRotationMatrix YawMatrix(FRotator(0.f, GetControlRotation().Yaw, 0.f));
+    const FVector ForwardDirection = YawMatrix.GetUnitAxis(EAxis::X);
+    const FVector RightDirection = YawMatrix.GetUnitAxis(EAxis::Y);
 
     /**
-     * 根据YawRotation计算右向方向向量（左右平移方向）
-     * GetUnitAxis(EAxis::Y)：获取Y轴单位向量，在UE坐标系中通常是右向
+     * 合并前后和左右分量，只调用一次AddMovementInput
+     * InputAxisVector.Y：正数向前，负数向后
+     * InputAxisVector.X：正数向右，负数向左
+     * 实际的移动速度和加速度由Pawn的MovementComponent控制（输入向量会被限制在单位长度内）
      */
-    const FVector RightDirection = FRotationMatrix(YawRotation).GetUnitAxis(EAxis::Y);
+    ControlledPawn->AddMovementInput(ForwardDirection * InputAxisVector.Y + RightDirection * InputAxisVector.X);
+}
+
+/**
+ * ClickMove 函数
+ * 点击/按住移动的输入回调
+ * 输入回调在Super::PlayerTick中执行，早于本帧的CursorTrace，此时读取光标结果会拿到上一次的旧结果
+ */
+void AAuraPlayerController::ClickMove(const FInputActionValue& InputActionValue)
+{
+    if (InputRecorder.IsReplaying()) return;
+
+    bClickMoveRequested = true;
+}
+
+/**
+ * ResolveClickMove 函数
+ * 光标悬停在敌人身上时不移动（点击敌人留给攻击和技能使用）
+ */
+void AAuraPlayerController::ResolveClickMove()
+{
+    if (!bClickMoveRequested) return;
+    bClickMoveRequested = false;
+
+    if (ThisActor.IsSet()) return;
+
+    FVector Destination;
+    if (FrameCursorHit.bBlockingHit)
+    {
+        SetMoveDestination(FrameCursorHit.ImpactPoint);
+    }
+    else if (GetCursorGroundPlanePoint(Destination))
+    {
+        SetMoveDestination(Destination);
+    }
+}
+
+/**
+ * SetMoveDestination 函数
+ * 目的地变化不超过阈值时复用已缓存的路径，超过阈值才发起新的异步寻路
+ */
+void AAuraPlayerController::SetMoveDestination(const FVector& Destination)
+{
+    if (bHasMoveDestination && FVector::DistSquared(Destination, MoveDestination) < FMath::Square(RepathDistanceThreshold))
+    {
+        return;
+    }
+
+    const APawn* ControlledPawn = GetPawn();
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+    if (!ControlledPawn || !NavSys) return;
+
+    const FNavAgentProperties& AgentProperties = ControlledPawn->GetNavAgentPropertiesRef();
+    const ANavigationData* NavData = NavSys->GetNavDataForProps(AgentProperties, ControlledPawn->GetNavAgentLocation());
+    if (!NavData) return;
+
+    // 新目的地使之前的请求失效，取消它以免浪费寻路线程的时间
+    if (PendingPathQueryId != INVALID_NAVQUERYID)
+    {
+        NavSys->AbortAsyncFindPathRequest(PendingPathQueryId);
+        PendingPathQueryId = INVALID_NAVQUERYID;
+    }
+
+    MoveDestination = Destination;
+    bHasMoveDestination = true;
 
     /**
-     * 获取此控制器当前控制的Pawn（角色）
-     * GetPawn<APawn>()：获取控制器控制的Pawn对象，并进行类型转换
-     * Pawn是玩家直接控制的游戏角色或载具
+     * 发起异步寻路
+     * 寻路在导航系统的异步队列中执行，结果在之后某一帧通过OnMovePathFound回到游戏线程
+     * 允许部分路径：目的地不可达（如点在墙上）时走到最近的可达点
+     * 请求完成前角色继续沿旧路径移动
      */
-    if (APawn* ControlledPawn = GetPawn<APawn>())
+    FPathFindingQuery Query(this, *NavData, ControlledPawn->GetNavAgentLocation(), Destination);
+    Query.SetAllowPartialPaths(true);
+
+    PendingPathQueryId = NavSys->FindPathAsync(
+        AgentProperties,
+        Query,
+        FNavPathQueryDelegate::CreateUObject(this, &AAuraPlayerController::OnMovePathFound),
+        EPathFindingMode::Regular);
+}
+
+/**
+ * OnMovePathFound 函数
+ * 只接受最近一次请求的结果，把路径点写入Spline
+ */
+void AAuraPlayerController::OnMovePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+{
+    if (QueryId != PendingPathQueryId) return;
+    PendingPathQueryId = INVALID_NAVQUERYID;
+
+    if (Result != ENavigationQueryResult::Success || !Path.IsValid() || Path->GetPathPoints().Num() == 0)
     {
-        /**
-         * 根据输入向量的Y分量（前向/后向）应用前向移动
-         * AddMovementInput()：将移动输入添加到Pawn的移动组件中
-         * 参数1：移动方向（单位向量）
-         * 参数2：移动强度（输入值，通常范围-1到1）
-         * InputAxisVector.Y：正数向前，负数向后
-         * 注意：实际的移动计算由Pawn的移动组件在物理更新时处理
-         */
-        ControlledPawn->AddMovementInput(ForwardDirection, InputAxisVector.Y);
+        StopAutoRun();
+        return;
+    }
 
-        /**
-         * 根据输入向量的X分量（左/右）应用右向移动
-         * InputAxisVector.X：正数向右，负数向左
-         * 这实现了基于摄像机方向的左右平移
-         */
-        ControlledPawn->AddMovementInput(RightDirection, InputAxisVector.X);
+    // 批量添加路径点，最后只更新一次样条
+    Spline->ClearSplinePoints(false);
+    for (const FNavPathPoint& PathPoint : Path->GetPathPoints())
+    {
+        Spline->AddSplinePoint(PathPoint.Location, ESplineCoordinateSpace::World, false);
+    }
+    Spline->UpdateSpline();
+
+    PathEndLocation = Path->GetPathPoints().Last().Location;
+    bAutoRunning = true;
+}
 
-        // 注意：AddMovementInput会累加移动输入，直到下一帧被清除
-        // 这使得按住按键可以持续移动，而无需每帧重新绑定输入
-        // 实际的移动速度和加速度由Pawn的MovementComponent控制
+/**
+ * AutoRun 函数
+ * 取角色在Spline上的最近点及该点的切线方向作为移动输入
+ * 角色被推开或绕过障碍时也能回到路径上，不需要重新寻路
+ */
+void AAuraPlayerController::AutoRun()
+{
+    if (!bAutoRunning) return;
+
+    APawn* ControlledPawn = GetPawn();
+    if (!ControlledPawn)
+    {
+        StopAutoRun();
+        return;
+    }
+
+    const FVector LocationOnSpline = Spline->FindLocationClosestToWorldLocation(ControlledPawn->GetActorLocation(), ESplineCoordinateSpace::World);
+    const FVector Direction = Spline->FindDirectionClosestToWorldLocation(LocationOnSpline, ESplineCoordinateSpace::World);
+    ControlledPawn->AddMovementInput(Direction);
+
+    // 导航路径点在导航网格高度上，与角色中心有高度差，只比较水平距离
+    if (FVector::DistSquared2D(LocationOnSpline, PathEndLocation) <= FMath::Square(AutoRunAcceptanceRadius))
+    {
+        StopAutoRun();
     }
-    // 如果没有控制任何Pawn，则移动输入被忽略（可能在角色死亡或切换时发生）
+}
+
+/**
+ * StopAutoRun 函数
+ * 清除目的地后，下一次点击无论距离多近都会重新寻路
+ */
+void AAuraPlayerController::StopAutoRun()
+{
+    if (PendingPathQueryId != INVALID_NAVQUERYID)
+    {
+        if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld()))
+        {
+            NavSys->AbortAsyncFindPathRequest(PendingPathQueryId);
+        }
+        PendingPathQueryId = INVALID_NAVQUERYID;
+    }
+
+    bAutoRunning = false;
+    bHasMoveDestination = false;
 }
 
 /**
@@ -246,23 +698,142 @@ void AAuraPlayerController::Move(const FInputActionValue& InputActionValue)
  * 通过射线检测从屏幕光标位置向游戏世界发射射线，检测命中的对象
  * 主要用于高亮敌人、显示交互提示等交互功能
  * 此函数在PlayerTick中每帧调用，确保实时响应
+ *
+ * 射线检测本身由UAuraCursorHitSubsystem完成（同步/异步、悬停缓存都在其中），
+ * 这里只读取ECC_Target通道的共享结果
  */
 void AAuraPlayerController::CursorTrace()
 {
+    // 本帧没有检测结果时（没有光标命中服务或视图）点击移动和范围选敌不使用上一帧的结果
+    FrameCursorHit = FHitResult();
+
+    UAuraCursorHitSubsystem* CursorHitSubsystem = GetCursorHitSubsystem();
+    if (!CursorHitSubsystem) return;
+
+    // 屏幕空间拾取：不经过物理系统，结果在本帧立即可用
+    if (CursorPickingMode == EAuraCursorPickingMode::ScreenSpace)
+    {
+        FVector2D CursorPosition;
+        FMatrix ViewProjection;
+        FIntRect ViewRect;
+        if (CursorHitSubsystem->GetCursorView(CursorPosition, ViewProjection, ViewRect))
+        {
+            ScreenSpaceCursorTrace(CursorPosition, ViewProjection, ViewRect);
+        }
+        return;
+    }
+
     /**
-     * 执行射线检测，获取光标下的碰撞结果
-     * FHitResult：射线检测结果结构，包含命中的详细信息
-     * ECC_Visibility: 使用可见性碰撞通道，通常用于可见物体的检测
-     * false: 不使用复杂碰撞（不进行三角形级别的精确检测，性能更好）
-     * true: 会忽略简单的碰撞体，使用更精确但更耗性能的复杂碰撞
-     * GetHitResultUnderCursor()是APlayerController的方法，从光标位置发射射线
+     * 读取光标命中结果
+     * ECC_Target: 选中目标专用的碰撞通道，角色身上只有悬停代理会阻挡该通道，场景几何默认阻挡
+     *   不会与摄像机、可见性等其他检测互相干扰，也不需要检测骨骼网格的物理资产，光标也不能穿墙选中敌人
+     * 结果未变化时（悬停缓存命中）高亮状态机会落在情况A或E，不会产生任何高亮调用
      */
+    FrameCursorHit = CursorHitSubsystem->GetCursorHit(ECC_Target);
+    HandleCursorHit(FrameCursorHit);
+}
+
+AActor* AAuraPlayerController::GetHoverTarget() const
+{
+    return IsLocalController() ? LocalHoverTarget.Get() : ServerHoverTarget.Get();
+}
+
+/**
+ * UpdateServerHoverTarget 函数
+ * 只有本地控制器上报；监听服务器的本地玩家调用RPC时直接在本地执行
+ */
+void AAuraPlayerController::UpdateServerHoverTarget()
+{
+    if (!IsLocalController()) return;
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    const double TimeSinceLastSend = Now - LastHoverTargetSendTime;
+    const bool bTargetChanged = LocalHoverTarget != SentHoverTarget;
+
+    // 目标变化但距离上次发送太近：等到间隔满足后再发送最新的目标
+    if (bTargetChanged ? TimeSinceLastSend < HoverTargetMinSendInterval : TimeSinceLastSend < HoverTargetResendInterval)
+    {
+        return;
+    }
+
+    SentHoverTarget = LocalHoverTarget;
+    LastHoverTargetSendTime = Now;
+    ServerSetHoverTarget(LocalHoverTarget.Get());
+}
+
+/**
+ * ServerSetHoverTarget 函数（服务器端执行）
+ * 校验客户端上报的目标，不合法时视为没有目标
+ * 目标必须存在于同一个世界、是注册表中的敌人，并且在玩家角色附近
+ */
+void AAuraPlayerController::ServerSetHoverTarget_Implementation(AActor* Target)
+{
+    const APawn* ControlledPawn = GetPawn();
+    const UAuraEnemyRegistry* EnemyRegistry = GetEnemyRegistry();
+    const bool bValidTarget = IsValid(Target)
+        && Target->GetWorld() == GetWorld()
+        && EnemyRegistry && EnemyRegistry->FindHandle(Target).IsSet()
+        && ControlledPawn
+        && FVector::DistSquared(Target->GetActorLocation(), ControlledPawn->GetActorLocation()) <= FMath::Square(MaxHoverTargetDistance);
+
+    ServerHoverTarget = bValidTarget ? Target : nullptr;
+
+    // 被玩家选中视为交战，延迟创建ASC的敌人在这里创建
+    AAuraEnemy* Enemy = bValidTarget ? Cast<AAuraEnemy>(Target) : nullptr;
+    if (Enemy)
+    {
+        Enemy->NotifyEngaged();
+    }
+}
+
+/**
+ * GetCursorHitSubsystem 函数
+ * 获取本地玩家的光标命中服务，非本地控制器返回nullptr
+ */
+UAuraCursorHitSubsystem* AAuraPlayerController::GetCursorHitSubsystem() const
+{
+    return ULocalPlayer::GetSubsystem<UAuraCursorHitSubsystem>(GetLocalPlayer());
+}
+
+/**
+ * ScreenSpaceCursorTrace 函数
+ * 屏幕空间拾取后端：每帧把注册表中所有敌人的包围盒投影到屏幕网格，
+ * 再查询光标所在格子，取离摄像机最近的敌人
+ * 结果包装成FHitResult交给HandleCursorHit，高亮状态机与物理后端完全共用
+ */
+void AAuraPlayerController::ScreenSpaceCursorTrace(const FVector2D& CursorPosition, const FMatrix& ViewProjection, const FIntRect& ViewRect)
+{
+    const UAuraEnemyRegistry* EnemyRegistry = GetEnemyRegistry();
+    if (!EnemyRegistry) return;
+
+    ScreenSpacePicker.Rebuild(ViewProjection, ViewRect, EnemyRegistry->GetEnemies());
+
     FHitResult CursorHit;
-    GetHitResultUnderCursor(ECC_Visibility, false, CursorHit);
+    if (AActor* PickedActor = ScreenSpacePicker.Pick(CursorPosition))
+    {
+        CursorHit = FHitResult(PickedActor, nullptr, PickedActor->GetActorLocation(), FVector::UpVector);
+        CursorHit.bBlockingHit = true;
+    }
+
+    FrameCursorHit = CursorHit;
+    HandleCursorHit(CursorHit);
+}
+
+/**
+ * HandleCursorHit 函数
+ * 根据光标射线检测结果更新LastActor/ThisActor并处理高亮切换
+ * @param CursorHit 光标射线检测结果，来自同步或异步检测
+ */
+void AAuraPlayerController::HandleCursorHit(const FHitResult& CursorHit)
+{
+    const UAuraEnemyRegistry* EnemyRegistry = GetEnemyRegistry();
+    if (!EnemyRegistry) return;
 
-    // 如果没有击中任何物体（射线没有碰到任何碰撞体），则直接返回
-    // bBlockingHit为true表示射线被碰撞体阻挡，为false表示没有命中或穿透
-    if (!CursorHit.bBlockingHit) return;
+    /**
+     * 光标检测使用ECC_Target通道，角色身上只有悬停代理会阻挡该通道，墙壁和地面同样会阻挡
+     * 没有命中或命中的不是已注册的敌人（场景几何）时得到空句柄，
+     * 下面的状态机会按"ThisActor为空"处理，取消上一个目标的高亮
+     */
 
     /**
      * 保存上一帧检测到的Actor到LastActor
@@ -272,13 +843,21 @@ void AAuraPlayerController::CursorTrace()
     LastActor = ThisActor;
 
     /**
-     * 将击中的Actor转换为IEnemyInterface接口指针
-     * Cast<IEnemyInterface>()：尝试将Actor转换为指定接口类型
-     * 如果Actor实现了IEnemyInterface接口，则返回有效指针，否则返回nullptr
-     * 这种设计使得系统可以处理任何实现了敌人接口的对象，而不关心具体类型
+     * 在敌人注册表中查找击中的Actor对应的句柄
+     * 注册时已经完成接口转换，这里只是一次哈希查找，不需要Cast<IEnemyInterface>
+     * Actor不是已注册的敌人（或没有命中）时得到空句柄
      * GetActor()返回射线击中的AActor对象
      */
-    ThisActor = Cast<IEnemyInterface>(CursorHit.GetActor());
+    ThisActor = EnemyRegistry->FindHandle(CursorHit.GetActor());
+    LocalHoverTarget = EnemyRegistry->GetActor(ThisActor);
+
+    /**
+     * 解析两个句柄得到接口指针（O(1)数组访问）
+     * 上一帧悬停的敌人如果已经被销毁或回收，LastEnemy为nullptr，按"LastActor为空"处理，
+     * 不会对已销毁的敌人调用UnHighlightActor
+     */
+    IEnemyInterface* LastEnemy = EnemyRegistry->Resolve(LastActor);
+    IEnemyInterface* ThisEnemy = EnemyRegistry->Resolve(ThisActor);
 
     /**
      * 鼠标射线检测逻辑分析（5种情况）：
@@ -305,15 +884,15 @@ void AAuraPlayerController::CursorTrace()
      */
 
      // 情况A和B：LastActor为空（上一帧没有检测到敌人）
-    if (LastActor == nullptr)
+    if (LastEnemy == nullptr)
     {
         // 情况B：LastActor为空，ThisActor有效（新检测到敌人）
-        if (ThisActor != nullptr)
+        if (ThisEnemy != nullptr)
         {
             // Case B: 高亮ThisActor（新检测到的敌人）
             // 调用敌人的高亮函数，通常会使敌人发光或显示轮廓
             // 注意：函数名应该是HighlightActor，不是HightlightActor
-            ThisActor->HighlightActor();
+            ThisEnemy->HighlightActor();
         }
         // 情况A：LastActor为空，ThisActor为空（光标在空白区域）
         else
@@ -326,12 +905,16 @@ void AAuraPlayerController::CursorTrace()
     else
     {
         // 情况C：LastActor有效，ThisActor为空（敌人离开光标范围）
-        if (ThisActor == nullptr)
+        if (ThisEnemy == nullptr)
         {
             // Case C: 取消LastActor的高亮（敌人离开光标范围）
             // 调用敌人的取消高亮函数，恢复敌人正常外观
             // 注意：函数名应该是UnHighlightActor，不是UnHightlightActor
-            LastActor->UnHighlightActor();
+            // 如果该敌人仍在范围选敌结果中，保持高亮
+            if (!IsAreaTarget(LastActor))
+            {
+                LastEnemy->UnHighlightActor();
+            }
         }
         // 情况D和E：ThisActor有效（当前帧也检测到了敌人）
         else
@@ -342,8 +925,11 @@ void AAuraPlayerController::CursorTrace()
                 // Case D: 高亮新敌人，取消旧敌人的高亮
                 // 先高亮新敌人，再取消旧敌人的高亮
                 // 顺序重要：确保视觉上不会出现两个敌人都高亮的情况
-                ThisActor->HighlightActor();
-                LastActor->UnHighlightActor();
+                ThisEnemy->HighlightActor();
+                if (!IsAreaTarget(LastActor))
+                {
+                    LastEnemy->UnHighlightActor();
+                }
             }
             // 情况E：两个Actor相同（光标停留在同一个敌人身上）
             else
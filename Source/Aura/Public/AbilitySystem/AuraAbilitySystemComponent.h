@@ -13,5 +13,13 @@ UCLASS()
 class AURA_API UAuraAbilitySystemComponent : public UAbilitySystemComponent
 {
     GENERATED_BODY()
-    
+
+public:
+    /**
+     * 清除运行时状态，用于对象池回收敌人
+     * 取消所有正在执行的能力、移除所有GameplayEffect和GameplayCue
+     * 已授予的能力保留，下一次取出时不需要重新授予
+     * 只能在服务器上调用
+     */
+    void ResetRuntimeState();
 };
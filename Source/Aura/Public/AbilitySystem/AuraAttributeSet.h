@@ -88,6 +88,19 @@
     GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
     GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
 
+/**
+ * 休眠属性
+ * 延迟创建ASC的敌人在首次交战前用它保存属性值（16字节，不是UObject）
+ * ASC创建时通过UAuraAttributeSet::InitFromDormant写入属性集
+ */
+struct FAuraDormantAttributes
+{
+    float Health = 0.f;
+    float MaxHealth = 0.f;
+    float Mana = 0.f;
+    float MaxMana = 0.f;
+};
+
 /**
  * AURA角色属性集类
  * 继承自Unreal Engine的UAttributeSet，用于定义和管理游戏中的角色属性
@@ -107,6 +120,26 @@ public:
      */
     virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
+    /**
+     * 把所有属性恢复为默认值（本类CDO中的初始值）
+     * 用于对象池回收敌人：下一次取出时属性与新生成的敌人完全相同
+     * 通过ASC设置基础值，聚合器和属性变化委托都会得到通知
+     * 调用前应先移除所有GameplayEffect，否则当前值仍会包含效果的修改
+     */
+    void ResetToDefaults();
+
+    /**
+     * 获取属性默认值（本类CDO中的初始值）的休眠副本
+     * 延迟创建ASC的敌人在BeginPlay和回收到对象池时使用
+     */
+    static FAuraDormantAttributes MakeDormantDefaults();
+
+    /**
+     * 用休眠属性初始化（在添加到ASC之前调用）
+     * @param Dormant 敌人休眠期间保存的属性值
+     */
+    void InitFromDormant(const FAuraDormantAttributes& Dormant);
+
     //=============================================
     // 基础生命值属性
     //=============================================
@@ -0,0 +1,41 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffectTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "AuraEffectSpecCacheSubsystem.generated.h"
+
+class AAuraEffectActor;
+
+/**
+ * 效果Actor的GameplayEffect规格缓存（世界子系统）
+ * 每个效果Actor类只构建一次输出规格（等级、SetByCaller数值、动态标签），之后每次拾取直接应用缓存的规格
+ *
+ * 性能特点：
+ * 构建规格需要分配效果上下文、计算修改器数值、复制标签，
+ * 同一类效果Actor的规格完全相同，没有必要在每次拾取时重复构建
+ * ApplyGameplayEffectSpecToSelf会复制传入的规格，缓存的规格本身不会被修改，可以反复应用
+ *
+ * 注意：规格从效果Actor类的默认对象构建，关卡中单个实例上修改的效果参数不会生效
+ * 缓存随世界一起销毁，编辑器中修改效果Actor类默认值后重新开始PIE即可生效
+ */
+UCLASS()
+class AURA_API UAuraEffectSpecCacheSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 获取效果Actor类的输出规格
+     * 第一次调用时从类默认对象构建并缓存
+     * @return 规格句柄，效果Actor类没有设置GameplayEffect时无效
+     */
+    FGameplayEffectSpecHandle GetOutgoingSpec(const AAuraEffectActor* EffectActor);
+
+private:
+    /** 效果Actor类到输出规格的映射，无效句柄也会缓存，避免重复尝试构建 */
+    TMap<TObjectKey<UClass>, FGameplayEffectSpecHandle> CachedSpecs;
+};
@@ -0,0 +1,26 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "AuraHealthPotionEffect.generated.h"
+
+/**
+ * 血瓶效果（GE_HealthPotion）
+ * 即时效果，目标的生命值增加HealAmount点
+ *
+ * 作为AAuraEffectActor的默认GameplayEffectClass，BP_HealthPotion直接继承该默认值；
+ * 需要不同数值的药水可以从该类派生蓝图，或在效果Actor上通过SetByCaller传入数值
+ */
+UCLASS()
+class AURA_API UAuraHealthPotionEffect : public UGameplayEffect
+{
+    GENERATED_BODY()
+
+public:
+    UAuraHealthPotionEffect();
+
+    /** 恢复的生命值 */
+    static constexpr float HealAmount = 25.f;
+};
@@ -4,12 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "GameplayEffectTypes.h"
 #include "AuraEffectActor.generated.h"
 
 // 前向声明USphereComponent类，避免包含头文件
 // 前向声明是一种编译优化，只声明类名而不包含其完整定义
 // 适用于在头文件中使用指针或引用类型时
 class USphereComponent;
+class UGameplayEffect;
 
 /**
  * Aura效果Actor类
@@ -18,10 +20,19 @@ class USphereComponent;
  * 功能说明：
  * 1. 通过碰撞检测与玩家或敌人交互
  * 2. 应用游戏效果（如治疗、属性增益）
+ *    应用GameplayEffectClass（默认为血瓶效果UAuraHealthPotionEffect），规格按类缓存在UAuraEffectSpecCacheSubsystem中
  * 3. 提供视觉表现和交互反馈
  *
  * 设计模式：
  * 使用组件化设计，将视觉、碰撞和逻辑分离
+ *
+ * 对象池：
+ * 被拾取后不再销毁，而是交给UAuraPickupPoolSubsystem回收（隐藏、禁用碰撞、进入网络休眠），
+ * RespawnDelay大于0时在原地按时重新出现，否则留在对象池中等待刷新点复用
+ *
+ * 实例化渲染：
+ * 开启UAuraDeveloperSettings::bInstancedPickupVisuals时，网格组件只作为模板（网格、覆盖材质、变换）并隐藏，
+ * 由UAuraPickupVisualsSubsystem按网格和材质合批渲染，效果Actor只保留碰撞和拾取逻辑
  */
 UCLASS()
 class AURA_API AAuraEffectActor : public AActor
@@ -86,6 +97,36 @@ public:
         int32 OtherBodyIndex
     );
 
+    /**
+     * 声明需要网络复制的属性（bPooled）
+     */
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    /**
+     * 回收到对象池（只在服务器上调用，由UAuraPickupPoolSubsystem::ReleasePickup调用）
+     * 隐藏、禁用碰撞，把状态复制到客户端后进入网络休眠
+     */
+    void DeactivateForPool();
+
+    /**
+     * 从对象池取出（只在服务器上调用，由UAuraPickupPoolSubsystem调用）
+     * 传送到指定位置，恢复可见性和碰撞
+     */
+    void ActivateFromPool(const FTransform& SpawnTransform);
+
+    /** 是否处于对象池中（已被拾取、尚未重新出现） */
+    bool IsPooled() const { return bPooled; }
+
+    /** 被拾取后在原地重新出现的延迟（秒），小于等于0时不自动出现，留给刷新点复用 */
+    float GetRespawnDelay() const { return RespawnDelay; }
+
+    /**
+     * 构建输出的GameplayEffect规格（等级、SetByCaller数值、动态标签）
+     * 由UAuraEffectSpecCacheSubsystem在类默认对象上调用，每个效果Actor类只构建一次
+     * @return 规格句柄，没有设置GameplayEffectClass时无效
+     */
+    FGameplayEffectSpecHandle MakeOutgoingSpec() const;
+
 protected:
     /**
      * 重写父类的BeginPlay函数，在游戏开始时调用
@@ -98,7 +139,63 @@ protected:
      */
     virtual void BeginPlay() override;
 
+    /** 通知对象池子系统该效果Actor被销毁（统计并从对象池中移除），释放实例化渲染的实例 */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /** 客户端收到复制的位置后同步实例化渲染的实例变换 */
+    virtual void PostNetReceiveLocationAndRotation() override;
+
+    /**
+     * 被拾取后在原地重新出现的延迟（秒）
+     * 小于等于0时不自动出现，留在对象池中等待UAuraPickupPoolSubsystem::AcquirePickup复用
+     */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pickup")
+    float RespawnDelay = 30.f;
+
+    /**
+     * 拾取时应用的GameplayEffect，默认为血瓶效果（UAuraHealthPotionEffect）
+     * 为空时拾取不生效并输出错误
+     * 以下效果参数只从类默认值读取（规格按类缓存），因此只能在蓝图类中编辑
+     */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Applied Effects")
+    TSubclassOf<UGameplayEffect> GameplayEffectClass;
+
+    /** GameplayEffect的等级 */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Applied Effects", meta = (ClampMin = "1"))
+    float EffectLevel = 1.f;
+
+    /** SetByCaller数值（按标签），写入缓存的规格 */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Applied Effects")
+    TMap<FGameplayTag, float> SetByCallerMagnitudes;
+
+    /** 额外授予目标的动态标签，写入缓存的规格 */
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Applied Effects")
+    FGameplayTagContainer DynamicGrantedTags;
+
 private:
+    /**
+     * 是否处于对象池中
+     * 复制到客户端，客户端在OnRep中同步隐藏和碰撞状态
+     */
+    UPROPERTY(ReplicatedUsing = OnRep_Pooled)
+    bool bPooled = false;
+
+    /** bPooled复制回调 */
+    UFUNCTION()
+    void OnRep_Pooled();
+
+    /**
+     * 根据bPooled更新本地状态：可见性、碰撞、实例化渲染
+     * 服务器和客户端共用
+     */
+    void ApplyPooledState();
+
+    /**
+     * 更新实例化渲染
+     * 未被拾取时占用（或更新）一个实例并隐藏自己的网格组件，被拾取后释放实例
+     */
+    void UpdateInstancedVisuals();
+
     /**
      * 球体碰撞组件指针
      * UPROPERTY宏使其受到Unreal垃圾回收系统的管理
@@ -125,6 +222,7 @@ private:
      * 1. 通常设置为根组件，决定Actor的位置和旋转
      * 2. 可以设置为各种形状（药水瓶、宝箱、魔法符文等）
      * 3. 可以在蓝图中指定具体的网格模型
+     * 4. 开启实例化渲染时只作为模板，实例化渲染子系统读取它的网格、覆盖材质和变换
      *
      */
     UPROPERTY(VisibleAnywhere)
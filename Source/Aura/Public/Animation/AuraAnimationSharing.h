@@ -0,0 +1,111 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimationSharingTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraAnimationSharing.generated.h"
+
+/**
+ * 敌人的移动状态（动画共享使用）
+ * 由AAuraEnemy::GetAnimationMovementState根据移动组件计算
+ */
+UENUM(BlueprintType)
+enum class EAuraEnemyMovementState : uint8
+{
+    Idle,
+    Walk,
+
+    MAX UMETA(Hidden)
+};
+
+/**
+ * 动画共享原型
+ * 同一原型的敌人使用相同的动画，同一状态下的所有实例共享一个领导者网格的姿势
+ */
+UENUM(BlueprintType)
+enum class EAuraAnimationSharingArchetype : uint8
+{
+    GoblinSpear,
+    GoblinSlingshot,
+
+    MAX UMETA(Hidden)
+};
+
+/**
+ * 动画共享状态 = 原型 × 移动状态
+ * 顺序必须与AuraAnimationSharing::GetState一致：每个原型按EAuraEnemyMovementState的顺序排列
+ * 动画共享设置资产（UAnimationSharingSetup）中为每个状态指定动画序列
+ */
+UENUM(BlueprintType)
+enum class EAuraAnimationSharingState : uint8
+{
+    GoblinSpear_Idle,
+    GoblinSpear_Walk,
+    GoblinSlingshot_Idle,
+    GoblinSlingshot_Walk,
+
+    MAX UMETA(Hidden)
+};
+
+namespace AuraAnimationSharing
+{
+    /** 原型和移动状态对应的共享状态 */
+    constexpr uint8 GetState(EAuraAnimationSharingArchetype Archetype, EAuraEnemyMovementState MovementState)
+    {
+        return static_cast<uint8>(Archetype) * static_cast<uint8>(EAuraEnemyMovementState::MAX) + static_cast<uint8>(MovementState);
+    }
+
+    static_assert(GetState(EAuraAnimationSharingArchetype::MAX, EAuraEnemyMovementState::Idle) == static_cast<uint8>(EAuraAnimationSharingState::MAX),
+        "EAuraAnimationSharingState必须为每个原型列出所有移动状态");
+}
+
+/**
+ * 敌人动画共享状态处理器
+ * 动画共享管理器每帧为每个已注册的敌人调用一次，把敌人的原型和移动状态映射为共享状态
+ * 在动画共享设置资产中选择该类作为StateProcessorClass
+ */
+UCLASS()
+class AURA_API UAuraAnimationSharingStateProcessor : public UAnimationSharingStateProcessor
+{
+    GENERATED_BODY()
+
+public:
+    UAuraAnimationSharingStateProcessor();
+
+    virtual void ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState, bool& bShouldProcess) override;
+};
+
+/**
+ * 动画共享（世界子系统）
+ * 世界开始时按项目设置中的动画共享设置资产创建动画共享管理器，并负责敌人的注册和注销
+ *
+ * 功能说明：
+ * 1. 每个共享状态只有少数几个领导者网格真正执行动画，其余同状态的敌人直接复制领导者的姿势
+ * 2. 敌人激活时注册、进入对象池或销毁时注销（见AAuraEnemy::ApplyPooledState）
+ * 3. 专用服务器不需要动画，不创建管理器
+ * 4. 控制台变量a.Sharing.Enabled可在运行时关闭动画共享
+ */
+UCLASS()
+class AURA_API UAuraAnimationSharingSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /** 世界开始时创建动画共享管理器 */
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    /**
+     * 注册一个敌人（按角色网格的骨架选择共享设置）
+     * 没有动画共享管理器或骨架不在设置资产中时不做任何事
+     */
+    void RegisterEnemy(AActor* Enemy, const USkeletalMeshComponent* Mesh) const;
+
+    /** 注销一个敌人，恢复其网格的独立动画 */
+    void UnregisterEnemy(AActor* Enemy) const;
+
+protected:
+    /** 只在游戏世界中创建（编辑器世界不需要） */
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+};
@@ -0,0 +1,82 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "AuraEnemyAnimInstance.generated.h"
+
+class UCharacterMovementComponent;
+
+/**
+ * 敌人动画实例代理
+ * 代理在游戏线程上（PreUpdate）从角色移动组件复制一份移动状态，
+ * 之后的计算只读取这份副本，可以在工作线程上执行
+ */
+USTRUCT()
+struct AURA_API FAuraEnemyAnimInstanceProxy : public FAnimInstanceProxy
+{
+    GENERATED_BODY()
+
+    FAuraEnemyAnimInstanceProxy() = default;
+    explicit FAuraEnemyAnimInstanceProxy(UAnimInstance* InAnimInstance) : FAnimInstanceProxy(InAnimInstance) {}
+
+    /** 复制移动状态（游戏线程） */
+    virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+
+    /** 角色速度 */
+    FVector Velocity = FVector::ZeroVector;
+
+    /** 是否有加速度输入（AI正在移动） */
+    bool bHasAcceleration = false;
+
+    /** 是否在空中 */
+    bool bIsFalling = false;
+};
+
+/**
+ * 敌人动画实例基类
+ * 敌人的动画蓝图（ABP_Enemy）应以该类为父类，并在动画图表中只读取这里的属性，不再使用事件图表
+ *
+ * 功能说明：
+ * 1. 移动状态由代理在PreUpdate中复制（游戏线程上只有几次读取）
+ * 2. 地面速度、是否移动等派生值在NativeThreadSafeUpdateAnimation中计算，在工作线程上执行
+ * 3. 动画蓝图中启用"Use Multi Threaded Animation Update"后，整个动画更新都不占用游戏线程
+ *
+ * 之后添加攻击状态时，同样在代理中复制、在NativeThreadSafeUpdateAnimation中计算
+ */
+UCLASS(Transient, Blueprintable)
+class AURA_API UAuraEnemyAnimInstance : public UAnimInstance
+{
+    GENERATED_BODY()
+
+public:
+    /** 水平速度（厘米/秒） */
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+    float GroundSpeed = 0.f;
+
+    /** 是否应播放移动动画（有速度且有加速度输入） */
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+    bool bShouldMove = false;
+
+    /** 是否在空中 */
+    UPROPERTY(Transient, BlueprintReadOnly, Category = "Movement")
+    bool bIsFalling = false;
+
+protected:
+    /** 在工作线程上根据代理复制的移动状态计算动画属性 */
+    virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
+    // 使用成员代理，不单独分配
+    virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+    virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+
+    /** 移动速度低于该值（厘米/秒）时视为静止 */
+    UPROPERTY(EditDefaultsOnly, Category = "Movement")
+    float MoveSpeedThreshold = 3.f;
+
+private:
+    UPROPERTY(Transient)
+    FAuraEnemyAnimInstanceProxy Proxy;
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "AbilitySystemInterface.h"
 #include "GameFramework/Character.h"
+#include "Game/AuraSignificanceTypes.h"
 #include "AuraCharacterBase.generated.h"
 
 // 前向声明能力系统相关类，避免不必要的头文件包含
@@ -14,6 +15,9 @@ class UAbilitySystemComponent;
 // UAttributeSet: 属性集基类，定义和管理角色的各种属性
 class UAttributeSet;
 
+// UCapsuleComponent: 胶囊体碰撞组件，用作选中目标的悬停代理
+class UCapsuleComponent;
+
 /**
  * Aura角色基类
  * 这是一个抽象基类，用于游戏中所有角色的基础功能
@@ -43,8 +47,9 @@ public:
     /**
      * 构造函数
      * 初始化角色基类的基本属性和组件
+     * 接收FObjectInitializer，子类可以替换默认组件的类型（例如敌人使用预算骨骼网格）
      */
-    AAuraCharacterBase();
+    AAuraCharacterBase(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
     /**
      * 实现 IAbilitySystemInterface 接口的 GetAbilitySystemComponent 函数
@@ -73,6 +78,24 @@ public:
      */
     UAttributeSet* GetAttributeSet() const { return AttributeSet; }
 
+    /**
+     * 设置重要性等级（由UAuraSignificanceSubsystem调用）
+     * 按等级设置Actor/ASC的Tick间隔、动画Tick间隔、移动组件Tick间隔和网络更新频率
+     * 角色网格受动画预算分配器管理时，动画不使用固定间隔，而是把等级换算为预算分配器的重要性
+     * @param Bucket 新的重要性等级
+     * @param Settings 该等级对应的更新频率
+     */
+    void SetSignificanceBucket(EAuraSignificanceBucket Bucket, const FAuraSignificanceBucketSettings& Settings);
+
+    /** 当前的重要性等级 */
+    EAuraSignificanceBucket GetSignificanceBucket() const { return SignificanceBucket; }
+
+    /**
+     * 恢复类默认的更新频率（关闭重要性系统时调用）
+     * Tick间隔和网络更新频率取自类默认对象和组件模板，等级恢复为High
+     */
+    void ResetSignificance();
+
 protected:
     /**
      * 重写父类的BeginPlay函数，在角色开始游戏时调用
@@ -104,6 +127,19 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Combat")
     TObjectPtr<USkeletalMeshComponent> Weapon;
 
+    /**
+     * 悬停代理组件
+     * 一个只响应ECC_Target通道的简单胶囊体，专门用于光标选中和范围选敌
+     *
+     * 设计说明：
+     * 1. 光标检测不再需要检测骨骼网格的物理资产（每个骨骼一个刚体），只检测一个胶囊体
+     * 2. 骨骼网格忽略ECC_Target，悬停代理忽略其他所有通道，
+     *    选中检测与摄像机、可见性等检测互不干扰
+     * 3. 尺寸可以在蓝图中按敌人体型调整
+     */
+    UPROPERTY(VisibleAnywhere, Category = "Targeting")
+    TObjectPtr<UCapsuleComponent> HoverProxy;
+
     /**
      * 能力系统组件指针
      * UPROPERTY()宏使其受到Unreal垃圾回收系统的管理
@@ -135,6 +171,9 @@ protected:
     UPROPERTY()
     TObjectPtr<UAttributeSet> AttributeSet;
 
+    /** 当前的重要性等级，新生成的角色默认全频率更新 */
+    EAuraSignificanceBucket SignificanceBucket = EAuraSignificanceBucket::High;
+
     // 注意：根据GAS最佳实践，玩家角色通常将ASC和AttributeSet放在PlayerState中
     // 而AI控制的敌人角色可以直接放在Character中
 };  
\ No newline at end of file
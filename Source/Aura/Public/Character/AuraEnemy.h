@@ -5,8 +5,13 @@
 #include "CoreMinimal.h"
 #include "Character/AuraCharacterBase.h"
 #include "Interaction/EnemyInterface.h"
+#include "AbilitySystem/AuraAttributeSet.h"
+#include "Animation/AuraAnimationSharing.h"
 #include "AuraEnemy.generated.h"
 
+class UAuraAbilitySystemComponent;
+class UStaticMesh;
+
 /**
  * Aura游戏中的敌人角色类
  * 这个类继承自AAuraCharacterBase，同时实现了IEnemyInterface接口
@@ -83,8 +88,83 @@ public:
       * 构造函数声明
       * 在这里初始化敌人角色特有的属性和组件
       * 构造函数在对象创建时调用，用于设置默认值和初始化状态
+      * 角色网格替换为USkeletalMeshComponentBudgeted，由动画预算分配器管理更新频率
       */
-    AAuraEnemy();
+    AAuraEnemy(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+    /**
+     * 声明需要网络复制的属性（bPooled）
+     */
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    /**
+     * 回收到对象池（只在服务器上调用，由UAuraEnemyPoolSubsystem::ReleaseEnemy调用）
+     * 1. 重置GAS状态：取消能力、移除所有GameplayEffect和GameplayCue
+     * 2. 属性恢复为默认值
+     * 3. 隐藏Actor、禁用碰撞和Tick，从敌人注册表中注销（指向它的句柄全部失效）
+     */
+    void DeactivateForPool();
+
+    /**
+     * 从对象池取出（只在服务器上调用，由UAuraEnemyPoolSubsystem::AcquireEnemy调用）
+     * 传送到指定位置，恢复可见性、碰撞和Tick，并重新注册到敌人注册表
+     */
+    void ActivateFromPool(const FTransform& SpawnTransform);
+
+    /** 是否处于对象池中（未激活） */
+    bool IsPooled() const { return bPooled; }
+
+    /**
+     * 通知敌人进入交战（被玩家选中、受到效果、被AI仇恨时调用，只在服务器上生效）
+     * 延迟创建模式下（UAuraDeveloperSettings::bLazyEnemyAbilitySystem）在这里创建ASC和属性集，
+     * 已经创建过时不做任何事
+     */
+    UFUNCTION(BlueprintCallable, Category = "Ability System")
+    void NotifyEngaged();
+
+    /**
+     * 标记敌人在网络上活跃（只在服务器上生效）
+     * 记录活跃时间，处于网络休眠时立即唤醒
+     * 交战、属性变化、受到GameplayEffect时自动调用，AI开始移动或攻击时也应调用
+     */
+    UFUNCTION(BlueprintCallable, Category = "Network")
+    void MarkNetActive();
+
+    /** 最近一次网络活跃的时间（世界时间，秒），UAuraNetDormancySubsystem据此判断是否空闲 */
+    double GetLastNetActivityTime() const { return LastNetActivityTime; }
+
+    /** ASC和属性集是否已经创建 */
+    bool HasAbilitySystem() const { return AbilitySystemComponent != nullptr; }
+
+    /** 休眠属性，ASC创建之前用于读取敌人的属性值 */
+    const FAuraDormantAttributes& GetDormantAttributes() const { return DormantAttributes; }
+
+    /**
+     * 当前生命值
+     * ASC已创建时读取属性集，否则读取休眠属性
+     */
+    float GetCurrentHealth() const;
+
+    /**
+     * 设置当前生命值（只在服务器上调用，群体系统水合敌人时使用）
+     * ASC已创建时通过ASC设置基础值，否则写入休眠属性
+     */
+    void SetCurrentHealth(float NewHealth);
+
+    uint8 GetTeamId() const { return TeamId; }
+    void SetTeamId(uint8 NewTeamId) { TeamId = NewTeamId; }
+
+    /** 远处群体表示使用的静态网格（见UAuraCrowdSubsystem） */
+    UStaticMesh* GetCrowdMesh() const { return CrowdMesh; }
+
+    /** 动画共享原型 */
+    EAuraAnimationSharingArchetype GetAnimationSharingArchetype() const { return AnimationSharingArchetype; }
+
+    /**
+     * 当前移动状态（动画共享状态处理器每帧调用）
+     * 水平速度超过AnimationSharingWalkSpeed时为Walk，否则为Idle
+     */
+    EAuraEnemyMovementState GetAnimationMovementState() const;
 
 protected:
     /**
@@ -104,5 +184,93 @@ protected:
      */
     virtual void BeginPlay() override;
 
+    /**
+     * 重写父类的EndPlay函数，在敌人被销毁或关卡卸载时调用
+     * 从敌人注册表中注销自己，避免其他系统继续访问
+     */
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    /**
+     * 是否处于对象池中
+     * 复制到客户端，客户端在OnRep中同步隐藏、碰撞和注册表状态
+     */
+    UPROPERTY(ReplicatedUsing = OnRep_Pooled)
+    bool bPooled = false;
+
+    /** bPooled复制回调 */
+    UFUNCTION()
+    void OnRep_Pooled();
+
+    /**
+     * 根据bPooled更新本地状态：可见性、碰撞、Tick、敌人注册表
+     * 服务器和客户端共用
+     */
+    void ApplyPooledState();
+
+    /**
+     * 延迟模式下创建ASC和属性集（只在服务器上调用）
+     * 属性集用DormantAttributes初始化，ASC作为动态组件注册并复制到客户端
+     * 默认模式下ASC和属性集是构造函数中创建的默认子对象，不会调用到这里
+     */
+    void CreateAbilitySystem();
+
+    /**
+     * 初始化能力系统Actor信息，并让ASC沿用当前重要性等级的Tick间隔
+     * 默认模式：服务器和客户端都在BeginPlay中调用
+     * 延迟模式：服务器在CreateAbilitySystem中调用，客户端在OnRep_AbilitySystem中调用
+     */
+    void InitAbilitySystem();
+
+    /**
+     * 延迟模式下运行时创建的ASC（默认模式下为空）
+     * 基类的AbilitySystemComponent不复制，客户端通过这个指针得到服务器创建的组件
+     */
+    UPROPERTY(ReplicatedUsing = OnRep_AbilitySystem)
+    TObjectPtr<UAuraAbilitySystemComponent> ReplicatedAbilitySystem;
+
+    /** ReplicatedAbilitySystem复制回调 */
+    UFUNCTION()
+    void OnRep_AbilitySystem();
+
+    /** ASC创建之前的属性值 */
+    FAuraDormantAttributes DormantAttributes;
+
+    /** 队伍编号，群体系统在水合/脱水时与群体记录同步 */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Enemy")
+    uint8 TeamId = 1;
+
+    /**
+     * 远离玩家时群体表示使用的静态网格
+     * 通常是烘焙了顶点动画的网格，材质通过每实例自定义数据0读取动画时间偏移
+     * 为空时该敌人类不能加入群体系统
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Crowd")
+    TObjectPtr<UStaticMesh> CrowdMesh;
+
+    /**
+     * 动画共享原型，同一原型、同一移动状态的敌人共享一个领导者网格的姿势
+     * 项目设置的AnimationSharingArchetypes中有该敌人类的条目时，BeginPlay使用条目中的原型
+     */
+    UPROPERTY(EditDefaultsOnly, Category = "Animation Sharing")
+    EAuraAnimationSharingArchetype AnimationSharingArchetype = EAuraAnimationSharingArchetype::GoblinSpear;
+
+    /** 水平速度超过该值（厘米/秒）时使用Walk状态 */
+    UPROPERTY(EditDefaultsOnly, Category = "Animation Sharing", meta = (ClampMin = "0"))
+    float AnimationSharingWalkSpeed = 10.f;
+
+    /** 注册到（或注销自）敌人注册表和动画共享管理器 */
+    void SetActiveRegistration(bool bRegistered);
+
+    /** 按项目设置的AnimationSharingArchetypes确定动画共享原型 */
+    void ResolveAnimationSharingArchetype();
+
+    /** 属性变化回调（服务器），唤醒网络休眠 */
+    void OnAttributeChangedForDormancy(const FOnAttributeChangeData& Data);
+
+    /** 受到GameplayEffect回调（服务器），唤醒网络休眠 */
+    void OnGameplayEffectAppliedForDormancy(UAbilitySystemComponent* Source, const FGameplayEffectSpec& Spec, FActiveGameplayEffectHandle Handle);
+
+    /** 最近一次网络活跃的时间 */
+    double LastNetActivityTime = 0.0;
 
 };
@@ -0,0 +1,109 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Info.h"
+#include "Engine/NetSerialization.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "AuraCrowdReplicator.generated.h"
+
+class AAuraCrowdReplicator;
+class AAuraEnemy;
+struct FAuraCrowdAgentArray;
+
+/**
+ * 一个群体成员的复制快照
+ * 只包含客户端显示远处成员所需的数据：敌人类（决定网格）、位置、朝向、是否显示
+ * 生命值和队伍只在水合时使用，留在服务器上
+ */
+USTRUCT()
+struct FAuraCrowdAgentItem : public FFastArraySerializerItem
+{
+    GENERATED_BODY()
+
+    /** 敌人类，客户端据此找到群体类型（网格） */
+    UPROPERTY()
+    TSubclassOf<AAuraEnemy> EnemyClass;
+
+    /** 位置（Actor位置），量化到厘米 */
+    UPROPERTY()
+    FVector_NetQuantize Location;
+
+    /** 偏航角，压缩为一个字节 */
+    UPROPERTY()
+    uint8 CompressedYaw = 0;
+
+    /** 是否显示实例：存活且未水合（已水合的成员由复制过来的完整敌人显示） */
+    UPROPERTY()
+    bool bVisible = false;
+
+    // FFastArraySerializerItem，客户端收到变化时更新本地的实例化网格
+    void PostReplicatedAdd(const FAuraCrowdAgentArray& InArraySerializer);
+    void PostReplicatedChange(const FAuraCrowdAgentArray& InArraySerializer);
+    void PreReplicatedRemove(const FAuraCrowdAgentArray& InArraySerializer);
+};
+
+/** 群体成员快照数组，只复制发生变化的成员 */
+USTRUCT()
+struct FAuraCrowdAgentArray : public FFastArraySerializer
+{
+    GENERATED_BODY()
+
+    /** 成员快照，数组索引与服务器上的成员索引相同 */
+    UPROPERTY()
+    TArray<FAuraCrowdAgentItem> Items;
+
+    /** 所属的复制Actor（不复制，由复制Actor的构造函数设置） */
+    AAuraCrowdReplicator* Owner = nullptr;
+
+    bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+    {
+        return FFastArraySerializer::FastArrayDeltaSerialize<FAuraCrowdAgentItem, FAuraCrowdAgentArray>(Items, DeltaParms, *this);
+    }
+};
+
+template<>
+struct TStructOpsTypeTraits<FAuraCrowdAgentArray> : public TStructOpsTypeTraitsBase2<FAuraCrowdAgentArray>
+{
+    enum
+    {
+        WithNetDeltaSerializer = true,
+    };
+};
+
+/**
+ * 群体复制Actor
+ * 服务器上的UAuraCrowdSubsystem在联网游戏中生成一个，把所有成员的紧凑快照复制给每个客户端，
+ * 客户端的UAuraCrowdSubsystem据此在本地创建实例化网格，远处的敌人在客户端上同样可见
+ *
+ * 性能特点：
+ * 1. 对所有连接始终相关（复制图中作为AInfo进入AlwaysRelevantNode）
+ * 2. 快速数组只复制发生变化的成员；成员只在加入、水合、脱水、死亡时变化，
+ *    水合后的移动不复制（此时显示的是完整的敌人）
+ * 3. 每个成员约10字节（量化位置、压缩朝向、标记），数百个成员的初始复制也只有几KB
+ */
+UCLASS(NotPlaceable, Transient)
+class AURA_API AAuraCrowdReplicator : public AInfo
+{
+    GENERATED_BODY()
+
+public:
+    AAuraCrowdReplicator();
+
+    virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+    /**
+     * 更新一个成员的快照（只在服务器上调用）
+     * @param AgentIndex 服务器上的成员索引，超出当前数组时自动扩展
+     */
+    void SetAgent(int32 AgentIndex, TSubclassOf<AAuraEnemy> EnemyClass, const FVector& Location, float Yaw, bool bVisible);
+
+    /** 把快照的变化转发给客户端的群体子系统 */
+    void OnAgentReplicated(const FAuraCrowdAgentItem& Item);
+    void OnAgentRemoved(const FAuraCrowdAgentItem& Item);
+
+private:
+    UPROPERTY(Replicated)
+    FAuraCrowdAgentArray Agents;
+};
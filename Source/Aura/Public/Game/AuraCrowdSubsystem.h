@@ -0,0 +1,213 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "AuraCrowdSubsystem.generated.h"
+
+class AAuraCrowdReplicator;
+class AAuraEnemy;
+class UHierarchicalInstancedStaticMeshComponent;
+
+/** 一个群体类型：一个敌人类对应一个实例化网格组件 */
+USTRUCT()
+struct FAuraCrowdType
+{
+    GENERATED_BODY()
+
+    /** 水合时从对象池取出的敌人类 */
+    UPROPERTY()
+    TSubclassOf<AAuraEnemy> EnemyClass;
+
+    /** 该类型所有群体成员的实例化网格（敌人类的CrowdMesh），专用服务器上为空 */
+    UPROPERTY()
+    TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Instances;
+
+    /** 网格相对于Actor的变换（取自敌人类CDO的骨骼网格），实例变换 = MeshOffset * Actor变换 */
+    FTransform MeshOffset;
+
+    /** 已死亡成员的索引，新成员优先复用（实例索引保持不变） */
+    TArray<int32> FreeAgents;
+};
+
+/**
+ * 群体数据
+ * 每个字段单独存放在一个数组中，同一个成员在所有数组中的索引相同
+ * 距离检测只需要顺序读取Locations，不会把其他字段带进缓存
+ */
+struct FAuraCrowdFragments
+{
+    /** 位置（Actor位置，即胶囊体中心） */
+    TArray<FVector> Locations;
+
+    /** 朝向（偏航角） */
+    TArray<float> Yaws;
+
+    /** 当前生命值 */
+    TArray<float> Healths;
+
+    /** 队伍编号 */
+    TArray<uint8> Teams;
+
+    /** 群体类型索引（UAuraCrowdSubsystem::Types） */
+    TArray<uint8> TypeIndices;
+
+    /** 在所属类型实例化网格中的实例索引，成员创建后不再变化 */
+    TArray<int32> InstanceIndices;
+
+    /** 水合后对应的完整敌人，未水合时为空 */
+    TArray<TWeakObjectPtr<AAuraEnemy>> HydratedActors;
+
+    /** 是否存活 */
+    TBitArray<> Alive;
+
+    /** 是否已水合为完整的敌人 */
+    TBitArray<> Hydrated;
+
+    int32 Num() const { return Locations.Num(); }
+};
+
+/**
+ * 敌人群体（可Tick的世界子系统）
+ * 远离玩家的敌人只保存一条紧凑的群体记录（位置、朝向、生命值、队伍），
+ * 以实例化静态网格（通常带顶点动画材质）显示；靠近玩家时水合为完整的AAuraEnemy，离开后再脱水
+ *
+ * 功能说明：
+ * 1. 每个敌人类一个HISM，所有远处成员共享一次绘制调用，没有骨骼网格、武器、ASC或移动组件
+ * 2. 水合：从UAuraEnemyPoolSubsystem取出敌人，写入位置、生命值和队伍，隐藏对应实例
+ * 3. 脱水：读回敌人的位置、朝向、生命值和队伍，把敌人放回对象池，恢复对应实例
+ * 4. 水合半径与脱水半径不同（见UAuraDeveloperSettings的Crowd设置），避免在边界附近反复切换
+ * 5. 每帧的水合/脱水数量有上限，大量切换分摊到多帧，不会集中在一帧内从对象池取出敌人
+ * 6. 水合后的敌人被回收（死亡）或销毁时，对应的群体成员随之移除
+ * 7. 使用"stat AuraCrowd"查看成员数、已水合数和切换次数
+ *
+ * 入口：
+ * - 关卡中摆放的、设置了CrowdMesh的敌人：第一次有玩家Pawn时，离所有玩家超过CrowdDehydrateRadius的转换为群体成员
+ *   （UAuraDeveloperSettings::bCrowdConvertPlacedEnemies）
+ * - 刷怪逻辑：蓝图或C++调用AddAgent直接添加成员，由群体决定何时水合
+ *
+ * 联网：
+ * 群体只在服务器（或单机）上模拟，水合后的敌人照常复制到客户端
+ * 远处成员通过AAuraCrowdReplicator复制紧凑快照（敌人类、位置、朝向、是否显示），
+ * 客户端据此在本地创建实例化网格，远处的敌人在客户端上同样可见；专用服务器不创建实例化网格
+ *
+ * 为什么不使用Mass：
+ * MassEntity/MassCrowd的表示和复制依赖ZoneGraph车道导航和为每种实体编写的复制气泡，
+ * 而本项目的敌人使用导航网格、GAS和对象池；远处表示只需要位置、生命值和队伍，
+ * 水合直接复用现有的敌人对象池，不需要额外启用多个插件并制作ZoneGraph数据
+ */
+UCLASS()
+class AURA_API UAuraCrowdSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 添加一个群体成员
+     * @param EnemyClass 敌人类，必须设置了CrowdMesh
+     * @param Transform 初始位置和朝向（Actor变换）
+     * @param Health 初始生命值，小于0时使用属性集默认值
+     * @param TeamId 队伍编号
+     * @return 成员索引；客户端上或敌人类没有CrowdMesh时返回INDEX_NONE
+     */
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    int32 AddAgent(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& Transform, float Health = -1.f, uint8 TeamId = 1);
+
+    /**
+     * 把一个已存在的敌人（例如关卡中摆放的敌人）转换为群体成员
+     * 敌人的状态写入群体记录，敌人本身放回对象池
+     * @return 成员索引，失败时返回INDEX_NONE，敌人保持不变
+     */
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    int32 AddAgentFromEnemy(AAuraEnemy* Enemy);
+
+    /**
+     * 移除一个群体成员
+     * 已水合的成员只解除关联，敌人本身保持不变
+     */
+    UFUNCTION(BlueprintCallable, Category = "Crowd")
+    void RemoveAgent(int32 AgentIndex);
+
+    /** 已水合的敌人对应的成员索引，不是群体成员时返回INDEX_NONE */
+    int32 FindAgent(const AAuraEnemy* Enemy) const;
+
+    /** 存活的成员数量 */
+    int32 GetNumAgents() const { return NumAlive; }
+
+    /** 已水合的成员数量 */
+    int32 GetNumHydrated() const { return NumHydrated; }
+
+    /**
+     * 客户端：应用一个复制过来的成员快照（由AAuraCrowdReplicator调用）
+     * @param ReplicationID 快照在快速数组中的ID，客户端据此找到本地成员
+     */
+    void ApplyReplicatedAgent(int32 ReplicationID, TSubclassOf<AAuraEnemy> EnemyClass, const FVector& Location, float Yaw, bool bVisible);
+
+    /** 客户端：移除一个复制过来的成员 */
+    void RemoveReplicatedAgent(int32 ReplicationID);
+
+    // UTickableWorldSubsystem
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    /** 只在游戏世界中创建（编辑器世界不需要） */
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** 查找或创建敌人类的群体类型，敌人类没有CrowdMesh时返回INDEX_NONE */
+    int32 FindOrAddType(TSubclassOf<AAuraEnemy> EnemyClass);
+
+    /** 分配一个成员（优先复用同类型的死亡成员），位置等字段由调用方写入 */
+    int32 AllocateAgent(int32 TypeIndex);
+
+    /** 把关卡中摆放的远处敌人转换为群体成员（第一次有玩家Pawn时调用一次） */
+    void ConvertPlacedEnemies(TConstArrayView<FVector> Viewpoints);
+
+    /** 服务器：把成员的当前状态写入复制快照（单机时不做任何事） */
+    void SyncReplicatedAgent(int32 AgentIndex);
+
+    /** 水合一个成员，对象池取不出敌人时返回false */
+    bool HydrateAgent(int32 AgentIndex);
+
+    /** 脱水一个成员，把敌人放回对象池 */
+    void DehydrateAgent(int32 AgentIndex);
+
+    /** 成员死亡：隐藏实例，索引放入所属类型的空闲列表 */
+    void KillAgent(int32 AgentIndex);
+
+    /** 显示或隐藏成员的实例（隐藏时缩放为0），专用服务器上没有实例 */
+    void UpdateInstance(int32 AgentIndex, bool bVisible);
+
+    /** 群体类型 */
+    UPROPERTY()
+    TArray<FAuraCrowdType> Types;
+
+    /** 持有所有实例化网格组件的Actor，第一次添加类型时生成 */
+    UPROPERTY()
+    TObjectPtr<AActor> VisualsActor;
+
+    /** 敌人类到群体类型索引的映射 */
+    TMap<TSubclassOf<AAuraEnemy>, int32> TypeIndexByClass;
+
+    /** 群体数据 */
+    FAuraCrowdFragments Fragments;
+
+    /** 已水合的敌人到成员索引的映射 */
+    TMap<TObjectKey<AAuraEnemy>, int32> AgentByActor;
+
+    /** 服务器：群体复制Actor，联网游戏中第一次添加成员时生成 */
+    UPROPERTY()
+    TObjectPtr<AAuraCrowdReplicator> Replicator;
+
+    /** 客户端：快照ID到本地成员索引的映射 */
+    TMap<int32, int32> AgentByReplicationID;
+
+    /** 关卡中摆放的敌人是否已经转换过 */
+    bool bPlacedEnemiesConverted = false;
+
+    int32 NumAlive = 0;
+    int32 NumHydrated = 0;
+};
@@ -0,0 +1,174 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Interaction/AuraHighlightCategory.h"
+#include "Game/AuraSignificanceTypes.h"
+#include "Animation/AuraAnimationSharing.h"
+#include "AuraDeveloperSettings.generated.h"
+
+class UMaterialInterface;
+class UAnimationSharingSetup;
+class AAuraEnemy;
+
+/**
+ * 敌人对象池预热配置
+ * 世界开始时为指定的敌人类预先生成Count个实例放入对象池
+ */
+USTRUCT()
+struct FAuraEnemyPoolPrewarm
+{
+    GENERATED_BODY()
+
+    /** 敌人类（例如BP_Goblin_Spear） */
+    UPROPERTY(EditAnywhere, Category = "Enemy Pool")
+    TSoftClassPtr<AAuraEnemy> EnemyClass;
+
+    /** 预先生成的实例数量，应不小于一波敌人中该类的最大数量 */
+    UPROPERTY(EditAnywhere, Category = "Enemy Pool", meta = (ClampMin = "0"))
+    int32 Count = 0;
+};
+
+/**
+ * 敌人类的动画共享原型
+ * 覆盖敌人类（及其子类）上的AnimationSharingArchetype默认值，原型由配置数据决定，不依赖每个蓝图单独设置
+ */
+USTRUCT()
+struct FAuraAnimationSharingArchetypeMapping
+{
+    GENERATED_BODY()
+
+    /** 敌人类（例如BP_Goblin_Slingshot） */
+    UPROPERTY(EditAnywhere, Category = "Animation Sharing")
+    TSoftClassPtr<AAuraEnemy> EnemyClass;
+
+    /** 该敌人类使用的动画共享原型 */
+    UPROPERTY(EditAnywhere, Category = "Animation Sharing")
+    EAuraAnimationSharingArchetype Archetype = EAuraAnimationSharingArchetype::GoblinSpear;
+};
+
+/**
+ * Aura项目设置
+ * 在编辑器的"项目设置 -> Game -> Aura"中编辑，保存在DefaultGame.ini
+ *
+ * 使用方式：
+ * const UAuraDeveloperSettings* Settings = GetDefault<UAuraDeveloperSettings>();
+ */
+UCLASS(Config = Game, DefaultConfig, meta = (DisplayName = "Aura"))
+class AURA_API UAuraDeveloperSettings : public UDeveloperSettings
+{
+    GENERATED_BODY()
+
+public:
+    /** 构造函数：填充重要性等级的默认值 */
+    UAuraDeveloperSettings();
+
+    /**
+     * 高亮后端
+     * CustomDepth: 模板值 + 后期材质轮廓（默认）
+     * OverlayMaterial: 在网格上叠加共享的材质实例，没有额外的全屏后期开销
+     * 可使用控制台命令aura.Benchmark.Highlight对比两种后端的CPU开销
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Highlight")
+    EAuraHighlightBackend HighlightBackend = EAuraHighlightBackend::CustomDepth;
+
+    /**
+     * 叠加材质后端使用的基础材质
+     * 每个高亮类别以它为父材质创建一个共享的动态材质实例，并写入类别颜色
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Highlight", meta = (EditCondition = "HighlightBackend == EAuraHighlightBackend::OverlayMaterial"))
+    TSoftObjectPtr<UMaterialInterface> HighlightOverlayMaterial;
+
+    /** 叠加材质中颜色参数的名称 */
+    UPROPERTY(Config, EditAnywhere, Category = "Highlight", meta = (EditCondition = "HighlightBackend == EAuraHighlightBackend::OverlayMaterial"))
+    FName HighlightOverlayColorParameter = TEXT("Color");
+
+    /**
+     * 敌人对象池预热列表
+     * 只在服务器（或单机）上预热，客户端上的敌人由复制生成
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Enemy Pool")
+    TArray<FAuraEnemyPoolPrewarm> EnemyPoolPrewarm;
+
+    /**
+     * 敌人的ASC和属性集是否延迟到首次交战（被选中、受到效果、被AI仇恨）时才创建
+     * 开启后未交战的敌人只保存一份FAuraDormantAttributes，不占用GAS组件的内存，
+     * 关卡加载时也不需要为它们执行InitAbilityActorInfo
+     * 关闭时ASC和属性集作为默认子对象创建（与之前相同，蓝图中的组件设置保持有效）
+     * 在AAuraEnemy的构造函数中读取，修改后需要重启编辑器
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Enemy", meta = (ConfigRestartRequired = true))
+    bool bLazyEnemyAbilitySystem = false;
+
+    /**
+     * 每个重要性等级的距离阈值和更新频率，按EAuraSignificanceBucket的顺序排列
+     * 距离阈值应递增；使用"stat AuraSignificance"查看各等级的敌人数量
+     */
+    UPROPERTY(Config, EditAnywhere, EditFixedSize, Category = "Significance")
+    TArray<FAuraSignificanceBucketSettings> SignificanceBuckets;
+
+    /** 屏幕外（最近一段时间没有被渲染）的角色是否降低一级 */
+    UPROPERTY(Config, EditAnywhere, Category = "Significance")
+    bool bDemoteOffscreenSignificance = true;
+
+    /**
+     * 每帧重新评估的角色数量
+     * 角色按轮转方式评估，评估开销与角色总数无关，300个敌人约5帧全部更新一次
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Significance", meta = (ClampMin = "1"))
+    int32 SignificanceUpdatesPerFrame = 64;
+
+    /** 群体中的敌人进入该距离（厘米，到最近玩家）时水合为完整的AAuraEnemy */
+    UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "0"))
+    float CrowdHydrateRadius = 4000.f;
+
+    /**
+     * 完整的敌人离开该距离时脱水回群体表示
+     * 应大于CrowdHydrateRadius，避免在边界附近反复切换
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "0"))
+    float CrowdDehydrateRadius = 5000.f;
+
+    /** 每帧最多水合/脱水的敌人数量，把大量切换分摊到多帧 */
+    UPROPERTY(Config, EditAnywhere, Category = "Crowd", meta = (ClampMin = "1"))
+    int32 CrowdMaxTransitionsPerFrame = 8;
+
+    /**
+     * 第一次有玩家Pawn时，把关卡中摆放的、设置了CrowdMesh且离所有玩家超过CrowdDehydrateRadius的敌人转换为群体成员
+     * 没有设置CrowdMesh的敌人类不受影响
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Crowd")
+    bool bCrowdConvertPlacedEnemies = true;
+
+    /**
+     * 动画共享设置资产
+     * 为每个骨架指定状态处理器（UAuraAnimationSharingStateProcessor）、每个共享状态的动画和领导者数量
+     * 为空时不使用动画共享
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Animation Sharing")
+    TSoftObjectPtr<UAnimationSharingSetup> AnimationSharingSetup;
+
+    /**
+     * 敌人类到动画共享原型的映射
+     * 敌人匹配最具体的（继承层级最深的）条目；没有匹配的条目时使用敌人类上的AnimationSharingArchetype
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Animation Sharing")
+    TArray<FAuraAnimationSharingArchetypeMapping> AnimationSharingArchetypes;
+
+    /** 敌人静止且没有网络活跃（交战、属性变化、受到效果）超过该时间（秒）后进入网络休眠 */
+    UPROPERTY(Config, EditAnywhere, Category = "Network", meta = (ClampMin = "0"))
+    float EnemyNetDormancyDelay = 3.f;
+
+    /** 每帧检查网络休眠的敌人数量（轮转） */
+    UPROPERTY(Config, EditAnywhere, Category = "Network", meta = (ClampMin = "1"))
+    int32 EnemyNetDormancyChecksPerFrame = 64;
+
+    /**
+     * 未被拾取的效果Actor通过UAuraPickupVisualsSubsystem按网格合批渲染（每个网格一个实例化网格组件）
+     * 关闭时每个效果Actor使用自己的网格组件渲染
+     */
+    UPROPERTY(Config, EditAnywhere, Category = "Pickup")
+    bool bInstancedPickupVisuals = true;
+};
@@ -0,0 +1,83 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraEnemyPoolSubsystem.generated.h"
+
+class AAuraEnemy;
+
+/** 一个敌人类的对象池 */
+USTRUCT()
+struct FAuraEnemyPool
+{
+    GENERATED_BODY()
+
+    /** 处于对象池中、可以直接取出的敌人 */
+    UPROPERTY()
+    TArray<TObjectPtr<AAuraEnemy>> Inactive;
+};
+
+/**
+ * 敌人对象池（世界子系统）
+ * 按敌人类缓存已生成的敌人，成波刷怪时直接取出，死亡或撤离时放回
+ *
+ * 功能说明：
+ * 1. 世界开始时按项目设置（UAuraDeveloperSettings::EnemyPoolPrewarm）为每个敌人类预先生成实例
+ * 2. AcquireEnemy: 从对象池取出并激活，对象池为空时才生成新的敌人（记为一次未命中）
+ * 3. ReleaseEnemy: 重置GAS状态和属性、隐藏并禁用碰撞后放回对象池
+ * 4. 使用"stat AuraEnemyPool"查看取出/回收/未命中次数
+ *
+ * 性能特点：
+ * 每个敌人都带有ASC、属性集、武器等多个UObject，
+ * 复用实例使成波刷怪时没有UObject分配，也不会产生额外的垃圾回收压力
+ *
+ * 注意：对象池只在服务器（或单机）上工作，客户端的敌人状态通过AAuraEnemy::bPooled复制
+ */
+UCLASS()
+class AURA_API UAuraEnemyPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 世界开始时调用
+     * 按项目设置预热对象池
+     */
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    /**
+     * 为指定敌人类预先生成实例并放入对象池
+     * @param EnemyClass 敌人类
+     * @param Count 预先生成的数量（对象池中已有的实例也计算在内）
+     */
+    void Prewarm(TSubclassOf<AAuraEnemy> EnemyClass, int32 Count);
+
+    /**
+     * 取出一个敌人
+     * @param EnemyClass 敌人类
+     * @param SpawnTransform 出生位置
+     * @return 激活后的敌人；不是服务器或生成失败时返回nullptr
+     */
+    UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+    AAuraEnemy* AcquireEnemy(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& SpawnTransform);
+
+    /**
+     * 把敌人放回对象池（代替Destroy）
+     * @param Enemy 之前取出（或直接生成）的敌人，重复回收会被忽略
+     */
+    UFUNCTION(BlueprintCallable, Category = "Enemy Pool")
+    void ReleaseEnemy(AAuraEnemy* Enemy);
+
+    /** 指定敌人类在对象池中的实例数量 */
+    int32 GetNumInactive(TSubclassOf<AAuraEnemy> EnemyClass) const;
+
+private:
+    /** 生成一个新的敌人（不激活对象池逻辑） */
+    AAuraEnemy* SpawnEnemy(TSubclassOf<AAuraEnemy> EnemyClass, const FTransform& SpawnTransform) const;
+
+    /** 每个敌人类一个对象池 */
+    UPROPERTY()
+    TMap<TSubclassOf<AAuraEnemy>, FAuraEnemyPool> Pools;
+};
@@ -0,0 +1,81 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraNetDormancySubsystem.generated.h"
+
+class AAuraEnemy;
+class UNetDriver;
+
+/**
+ * 敌人网络休眠管理（可Tick的世界子系统，只在服务器上工作）
+ * 休眠的Actor不再出现在网络驱动每次更新需要考虑的Actor列表中，
+ * 大量静止的敌人不再占用服务器的复制开销
+ *
+ * 功能说明：
+ * 1. 每帧轮转检查EnemyNetDormancyChecksPerFrame个已注册的敌人
+ * 2. 静止且超过EnemyNetDormancyDelay秒没有网络活跃的敌人进入休眠（DORM_DormantAll）
+ * 3. 休眠中的敌人开始移动时唤醒；交战、属性变化、受到效果时由AAuraEnemy::MarkNetActive立即唤醒
+ * 4. 对象池中的敌人在回收时直接休眠（见AAuraEnemy::DeactivateForPool）
+ * 5. 控制台变量aura.Net.EnemyDormancy可关闭休眠管理（所有敌人立即唤醒），用于对比
+ * 6. 控制台命令aura.Net.DormancyReport输出每次网络更新考虑的Actor比例，
+ *    "stat AuraNet"显示同样的数据（每秒采样一次，不收集统计数据时不计算）
+ *
+ * 使用复制图（UAuraReplicationGraph）时，网络驱动的活跃列表不再决定每次更新考虑哪些Actor：
+ * 复制图按连接收集附近格子中的Actor，并跳过对该连接休眠的Actor。
+ * 此时报告和统计改为按连接估算：唤醒的Actor中始终相关的，或在连接视点的NetCullDistance以内的，
+ * 总数为复制Actor数 × 连接数（不使用复制图和休眠时每个连接都要考虑所有Actor）
+ */
+UCLASS()
+class AURA_API UAuraNetDormancySubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 输出网络休眠报告
+     * 所有复制Actor数 = 不使用休眠时每次网络更新需要考虑的数量，活跃Actor数 = 实际考虑的数量
+     */
+    void LogReport() const;
+
+    // UTickableWorldSubsystem
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    /** 只在游戏世界中创建（编辑器世界不需要） */
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** 检查一个敌人，必要时进入休眠或唤醒 */
+    void UpdateEnemyDormancy(AAuraEnemy* Enemy, double Now, double DormancyDelay) const;
+
+    /** 唤醒所有已注册的敌人（关闭休眠管理时调用一次） */
+    void WakeAllEnemies() const;
+
+    /** 轮转检查一部分敌人的休眠状态 */
+    void UpdateDormancy();
+
+    /** 采样网络对象统计（限频，只在收集统计数据时计算） */
+    void UpdateNetStats();
+
+    /** 两次统计采样的间隔（秒） */
+    static constexpr double NetStatsSampleInterval = 1.0;
+
+    /** 上一次统计采样的时间（FPlatformTime::Seconds） */
+    double LastNetStatsSampleTime = -UE_BIG_NUMBER;
+
+    /**
+     * 使用复制图时估算所有连接每次网络更新考虑的Actor数量之和
+     * 复制图按格子收集，实际数量可能略多于按NetCullDistance计算的结果
+     */
+    int32 CountGraphConsideredActors(const UNetDriver* NetDriver) const;
+
+    /** 下一个要检查的敌人在注册表列表中的索引 */
+    int32 NextIndex = 0;
+
+    /** 上一帧是否启用，用于检测关闭的时刻 */
+    bool bWasEnabled = true;
+};
@@ -0,0 +1,71 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AuraPickupPoolSubsystem.generated.h"
+
+class AAuraEffectActor;
+
+/** 一个效果Actor类的对象池 */
+USTRUCT()
+struct FAuraPickupPool
+{
+    GENERATED_BODY()
+
+    /** 处于对象池中、可以直接取出的效果Actor（不会自动重新出现的那些） */
+    UPROPERTY()
+    TArray<TObjectPtr<AAuraEffectActor>> Inactive;
+};
+
+/**
+ * 拾取物对象池（世界子系统）
+ * 效果Actor（药水等）被拾取后不再销毁，由这里回收和复用
+ *
+ * 功能说明：
+ * 1. ReleasePickup: 效果Actor被拾取时调用，隐藏并禁用碰撞
+ *    - RespawnDelay大于0：延迟后在原地重新出现（关卡中摆放的药水）
+ *    - 否则：放入对象池，等待刷新点通过AcquirePickup复用
+ * 2. AcquirePickup: 刷新点调用，从对象池取出并激活，对象池为空时才生成新的效果Actor
+ * 3. 使用"stat AuraPickupPool"查看生成、销毁、回收和重新出现的次数
+ *    长时间游戏中Pickups Spawned应趋于稳定，Pickups Destroyed应保持为0
+ *
+ * 注意：对象池只在服务器（或单机）上工作，客户端的状态通过AAuraEffectActor::bPooled复制
+ */
+UCLASS()
+class AURA_API UAuraPickupPoolSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 取出一个效果Actor
+     * @param PickupClass 效果Actor类
+     * @param SpawnTransform 出生位置
+     * @return 激活后的效果Actor；不是服务器或生成失败时返回nullptr
+     */
+    UFUNCTION(BlueprintCallable, Category = "Pickup Pool")
+    AAuraEffectActor* AcquirePickup(TSubclassOf<AAuraEffectActor> PickupClass, const FTransform& SpawnTransform);
+
+    /**
+     * 回收效果Actor（代替Destroy）
+     * @param Pickup 被拾取的效果Actor，重复回收会被忽略
+     */
+    UFUNCTION(BlueprintCallable, Category = "Pickup Pool")
+    void ReleasePickup(AAuraEffectActor* Pickup);
+
+    /** 效果Actor被销毁时调用（统计并从对象池中移除） */
+    void NotifyPickupDestroyed(AAuraEffectActor* Pickup);
+
+    /** 指定效果Actor类在对象池中的实例数量 */
+    int32 GetNumInactive(TSubclassOf<AAuraEffectActor> PickupClass) const;
+
+private:
+    /** 延迟结束，效果Actor在原地重新出现 */
+    void RespawnPickup(TWeakObjectPtr<AAuraEffectActor> WeakPickup);
+
+    /** 每个效果Actor类一个对象池 */
+    UPROPERTY()
+    TMap<TSubclassOf<AAuraEffectActor>, FAuraPickupPool> Pools;
+};
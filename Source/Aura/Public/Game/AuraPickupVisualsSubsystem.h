@@ -0,0 +1,126 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "AuraPickupVisualsSubsystem.generated.h"
+
+class AAuraEffectActor;
+class UHierarchicalInstancedStaticMeshComponent;
+class UMaterialInterface;
+class UStaticMesh;
+
+/**
+ * 批次键：网格 + 每个材质槽实际使用的材质
+ * 同一网格使用不同材质（例如红色和蓝色药水）的效果Actor分到不同的批次
+ */
+struct FAuraPickupVisualsBatchKey
+{
+    TObjectKey<UStaticMesh> Mesh;
+    TArray<TObjectKey<UMaterialInterface>, TInlineAllocator<4>> Materials;
+
+    bool operator==(const FAuraPickupVisualsBatchKey& Other) const
+    {
+        return Mesh == Other.Mesh && Materials == Other.Materials;
+    }
+
+    friend uint32 GetTypeHash(const FAuraPickupVisualsBatchKey& Key)
+    {
+        uint32 Hash = GetTypeHash(Key.Mesh);
+        for (const TObjectKey<UMaterialInterface>& Material : Key.Materials)
+        {
+            Hash = HashCombineFast(Hash, GetTypeHash(Material));
+        }
+        return Hash;
+    }
+};
+
+/** 一个批次的拾取物：网格和材质都相同的效果Actor共享一个实例化网格组件 */
+USTRUCT()
+struct FAuraPickupVisualsBatch
+{
+    GENERATED_BODY()
+
+    /** 该网格所有可见拾取物的实例化网格 */
+    UPROPERTY()
+    TObjectPtr<UHierarchicalInstancedStaticMeshComponent> Instances;
+
+    /** 空闲的实例索引（缩放为0），新的拾取物优先复用 */
+    TArray<int32> FreeInstances;
+};
+
+/** 一个效果Actor占用的实例 */
+struct FAuraPickupInstance
+{
+    /** 批次索引（UAuraPickupVisualsSubsystem::Batches） */
+    int32 BatchIndex = INDEX_NONE;
+
+    /** 在批次实例化网格中的实例索引 */
+    int32 InstanceIndex = INDEX_NONE;
+};
+
+/**
+ * 拾取物实例化渲染（世界子系统）
+ * 效果Actor的网格组件只作为模板（在蓝图中编辑网格、覆盖材质和变换）并隐藏，未被拾取的效果Actor按网格和材质合批，
+ * 同一网格、同一材质的所有药水只产生一次绘制调用
+ *
+ * 功能说明：
+ * 1. ShowPickup: 效果Actor出现（BeginPlay、从对象池取出、重新出现）时占用一个实例
+ * 2. HidePickup: 效果Actor被拾取或销毁时释放实例
+ * 3. 释放的实例缩放为0并放入空闲列表，不删除实例，其他效果Actor的实例索引保持不变
+ * 4. 使用"stat AuraPickupVisuals"查看批次数和可见实例数
+ *
+ * 注意：专用服务器不渲染，不创建该子系统
+ */
+UCLASS()
+class AURA_API UAuraPickupVisualsSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 显示效果Actor：占用（或更新）一个实例
+     * @param Pickup 效果Actor
+     * @param StaticMesh 网格
+     * @param Materials 每个材质槽的覆盖材质，为空或超出范围的槽使用网格自身的材质
+     * @param InstanceTransform 实例的世界变换
+     * @return 成功时返回true；没有网格时返回false
+     */
+    bool ShowPickup(const AAuraEffectActor* Pickup, UStaticMesh* StaticMesh, TConstArrayView<TObjectPtr<UMaterialInterface>> Materials, const FTransform& InstanceTransform);
+
+    /** 隐藏效果Actor：释放它占用的实例，没有占用时不做任何事 */
+    void HidePickup(const AAuraEffectActor* Pickup);
+
+    /** 可见的实例数量 */
+    int32 GetNumVisibleInstances() const { return InstanceByPickup.Num(); }
+
+protected:
+    /** 专用服务器不渲染，不需要创建 */
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+    /** 只在游戏世界中创建（编辑器世界不需要） */
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** 查找或创建网格和材质的批次 */
+    int32 FindOrAddBatch(UStaticMesh* StaticMesh, TConstArrayView<TObjectPtr<UMaterialInterface>> Materials);
+
+    /** 更新统计数据 */
+    void UpdateStats() const;
+
+    /** 网格批次 */
+    UPROPERTY()
+    TArray<FAuraPickupVisualsBatch> Batches;
+
+    /** 持有所有实例化网格组件的Actor，第一次创建批次时生成 */
+    UPROPERTY()
+    TObjectPtr<AActor> VisualsActor;
+
+    /** 批次键（网格和材质）到批次索引的映射 */
+    TMap<FAuraPickupVisualsBatchKey, int32> BatchIndexByKey;
+
+    /** 效果Actor到所占实例的映射 */
+    TMap<TObjectKey<AAuraEffectActor>, FAuraPickupInstance> InstanceByPickup;
+};
@@ -0,0 +1,116 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "AuraReplicationGraph.generated.h"
+
+/**
+ * Actor类的复制路由策略
+ * 决定一个复制Actor进入哪个全局节点
+ */
+enum class EAuraClassRepPolicy : uint8
+{
+    /** 不进入任何全局节点（由每连接节点或专用节点处理，例如玩家控制器、玩家状态） */
+    NotRouted,
+
+    /** 对所有连接始终相关（游戏状态等） */
+    RelevantAllConnections,
+
+    /** 空间网格：不会移动的Actor */
+    Spatialize_Static,
+
+    /** 空间网格：移动的Actor，每帧更新所在的格子 */
+    Spatialize_Dynamic,
+
+    /** 空间网格：休眠时按静态处理，唤醒后按动态处理（敌人、效果Actor） */
+    Spatialize_Dormancy,
+};
+
+/**
+ * 每连接节点：连接自己的玩家控制器、玩家状态、Pawn和视图目标
+ * 这些Actor只对所属连接相关（或对所属连接必须每帧复制），不进入空间网格
+ */
+UCLASS()
+class AURA_API UAuraReplicationGraphNode_OwnerConnection : public UReplicationGraphNode
+{
+    GENERATED_BODY()
+
+public:
+    // 该节点每帧从连接重新收集Actor，不接收路由
+    virtual void NotifyAddNetworkActor(const FNewReplicatedActorInfo& ActorInfo) override {}
+    virtual bool NotifyRemoveNetworkActor(const FNewReplicatedActorInfo& ActorInfo, bool bWarnIfNotFound = true) override { return false; }
+    virtual void NotifyResetAllNetworkActors() override {}
+
+    virtual void GatherActorListsForConnection(const FConnectionGatherActorListParameters& Params) override;
+
+private:
+    FActorRepListRefView ReplicationActorList;
+};
+
+/**
+ * Aura复制图
+ * 默认的网络驱动每次网络更新都要为每个连接考虑所有复制Actor，
+ * 复制图按空间把Actor分到网格中，每个连接只考虑自己附近格子中的Actor
+ *
+ * 节点结构：
+ * 1. GridNode（空间网格）：AAuraEnemy、AAuraEffectActor和其他Pawn，按NetCullDistance剔除
+ *    敌人和效果Actor使用休眠感知的路由，休眠（见UAuraNetDormancySubsystem）时按静态Actor处理
+ * 2. AlwaysRelevantNode：游戏状态、WorldSettings等AInfo
+ * 3. PlayerStateNode：所有玩家状态，按帧分批复制给所有连接
+ * 4. 每连接节点（UAuraReplicationGraphNode_OwnerConnection）：连接自己的控制器、玩家状态和Pawn每帧复制
+ *
+ * 服务器每次网络更新的开销与连接附近的Actor数量成正比，而不是与Actor总数成正比
+ *
+ * 启用方式：DefaultEngine.ini中IpNetDriver的ReplicationDriverClassName
+ */
+UCLASS(Transient, Config = Engine)
+class AURA_API UAuraReplicationGraph : public UReplicationGraph
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 修改一个Actor的复制频率（重要性系统调用）
+     * 复制图只在Actor加入时读取NetUpdateFrequency，之后的修改需要通过这里同步
+     */
+    void SetActorReplicationFrequency(AActor* Actor, float NetUpdateFrequency);
+
+    // UReplicationGraph
+    virtual void InitGlobalActorClassSettings() override;
+    virtual void InitGlobalGraphNodes() override;
+    virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+    virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+    virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+    /** 空间网格的格子大小（厘米），应接近敌人的NetCullDistance */
+    UPROPERTY(Config)
+    float GridCellSize = 10000.f;
+
+    /** 空间网格的原点偏移，网格从这里开始向正方向划分 */
+    UPROPERTY(Config)
+    FVector2D GridSpatialBias = FVector2D(-UE_OLD_WORLD_MAX, -UE_OLD_WORLD_MAX);
+
+private:
+    /** Actor的路由策略：优先使用按类设置的策略，否则根据CDO的相关性标记决定 */
+    EAuraClassRepPolicy GetClassPolicy(const AActor* Actor) const;
+
+    /**
+     * 按CDO的NetCullDistance和NetUpdateFrequency设置类的复制参数
+     * InitGlobalActorClassSettings对每个已加载的复制Actor类调用（例如AAuraCrowdReplicator的10次/秒）
+     */
+    void InitClassReplicationInfo(UClass* Class, bool bSpatialize);
+
+    UPROPERTY()
+    TObjectPtr<UReplicationGraphNode_GridSpatialization2D> GridNode;
+
+    UPROPERTY()
+    TObjectPtr<UReplicationGraphNode_ActorList> AlwaysRelevantNode;
+
+    UPROPERTY()
+    TObjectPtr<UReplicationGraphNode_PlayerStateFrequencyLimiter> PlayerStateNode;
+
+    /** 按类设置的路由策略 */
+    TClassMap<EAuraClassRepPolicy> ClassRepPolicies;
+};
@@ -0,0 +1,67 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Game/AuraSignificanceTypes.h"
+#include "AuraSignificanceSubsystem.generated.h"
+
+class AAuraCharacterBase;
+
+/**
+ * 重要性管理器（可Tick的世界子系统）
+ * 按与最近玩家的距离和是否在屏幕上，为每个敌人分配一个重要性等级，
+ * 并按等级降低远处敌人的Tick、动画、移动和网络更新频率
+ *
+ * 功能说明：
+ * 1. 敌人列表来自UAuraEnemyRegistry，每帧只评估SignificanceUpdatesPerFrame个敌人（轮转），
+ *    评估开销与敌人总数无关
+ * 2. 距离取到所有玩家Pawn（本地和远程）的最小距离，因此服务器上靠近任意玩家的敌人都保持高频率
+ * 3. 最近一段时间没有被渲染的敌人降低一级（专用服务器不渲染，不做该判断）
+ * 4. 只有等级变化时才调用AAuraCharacterBase::SetSignificanceBucket
+ * 5. 使用"stat AuraSignificance"查看各等级的敌人数量（每完成一轮轮转更新一次，统计同样不随敌人总数增长）
+ * 6. 控制台变量aura.Significance.Enable可在运行时关闭，关闭时所有敌人恢复类默认的Tick间隔和网络更新频率
+ *
+ * 等级阈值和更新频率见UAuraDeveloperSettings::SignificanceBuckets
+ */
+UCLASS()
+class AURA_API UAuraSignificanceSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 计算一个位置的重要性等级
+     * @param DistanceSquared 到最近玩家的距离平方
+     * @param bOnScreen 是否在屏幕上，不在屏幕上时降低一级
+     */
+    static EAuraSignificanceBucket ComputeBucket(double DistanceSquared, bool bOnScreen);
+
+    // UTickableWorldSubsystem
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+protected:
+    /** 只在游戏世界中创建（编辑器世界不需要） */
+    virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+    /** 评估一个敌人并在等级变化时应用 */
+    void EvaluateCharacter(AAuraCharacterBase* Character, TConstArrayView<FVector> Viewpoints, bool bUseVisibility);
+
+    /** 把所有已注册的敌人恢复到类默认的更新频率（关闭重要性系统时调用一次） */
+    void ResetAllToDefaults();
+
+    /** 发布各等级的敌人数量统计 */
+    void PublishBucketStats(const uint32 (&Counts)[static_cast<int32>(EAuraSignificanceBucket::MAX)]) const;
+
+    /** 下一个要评估的敌人在注册表列表中的索引 */
+    int32 NextIndex = 0;
+
+    /** 上一帧是否启用，用于检测关闭的时刻 */
+    bool bWasEnabled = true;
+
+    /** 本轮轮转中已评估的敌人在各等级的数量，一轮结束时发布到统计 */
+    uint32 RotationBucketCounts[static_cast<int32>(EAuraSignificanceBucket::MAX)] = {};
+};
@@ -0,0 +1,59 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AuraSignificanceTypes.generated.h"
+
+/**
+ * 重要性等级
+ * 按与最近玩家的距离划分，屏幕外的角色再降低一级
+ * 等级越低，Tick、动画、移动和网络更新的频率越低
+ */
+UENUM(BlueprintType)
+enum class EAuraSignificanceBucket : uint8
+{
+    /** 玩家附近且在屏幕上：全频率更新 */
+    High,
+
+    /** 中等距离 */
+    Medium,
+
+    /** 远处 */
+    Low,
+
+    /** 很远或远处且在屏幕外：最低频率更新 */
+    Minimal,
+
+    MAX UMETA(Hidden)
+};
+
+/**
+ * 一个重要性等级对应的更新频率
+ * 间隔为0表示每帧更新
+ */
+USTRUCT()
+struct FAuraSignificanceBucketSettings
+{
+    GENERATED_BODY()
+
+    /** 进入该等级的最大距离（厘米），最后一个等级忽略该值 */
+    UPROPERTY(EditAnywhere, Category = "Significance", meta = (ClampMin = "0"))
+    float MaxDistance = 0.f;
+
+    /** Actor和ASC的Tick间隔（秒） */
+    UPROPERTY(EditAnywhere, Category = "Significance", meta = (ClampMin = "0"))
+    float TickInterval = 0.f;
+
+    /** 骨骼网格（动画）的Tick间隔（秒） */
+    UPROPERTY(EditAnywhere, Category = "Significance", meta = (ClampMin = "0"))
+    float AnimationTickInterval = 0.f;
+
+    /** 角色移动组件的Tick间隔（秒） */
+    UPROPERTY(EditAnywhere, Category = "Significance", meta = (ClampMin = "0"))
+    float MovementTickInterval = 0.f;
+
+    /** 网络更新频率（次/秒），只在服务器上生效 */
+    UPROPERTY(EditAnywhere, Category = "Significance", meta = (ClampMin = "0.1"))
+    float NetUpdateFrequency = 100.f;
+};
@@ -0,0 +1,127 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "AuraEnemyRegistry.generated.h"
+
+class IEnemyInterface;
+
+/**
+ * 敌人句柄
+ * 指向注册表中一个槽位的弱引用：槽位索引 + 代数
+ *
+ * 敌人注销（销毁、回收到对象池）时槽位的代数加一，旧句柄随即失效，
+ * 即使该槽位之后被新的敌人复用，旧句柄也不会解析到新敌人身上
+ * 句柄只有8字节，可以按值复制和比较，不持有任何UObject引用
+ */
+struct FAuraEnemyHandle
+{
+    /** 槽位索引，INDEX_NONE表示空句柄 */
+    int32 Index = INDEX_NONE;
+
+    /** 注册时槽位的代数 */
+    uint32 Generation = 0;
+
+    /** 是否指向某个槽位（不代表敌人仍然存活，存活与否需要通过注册表解析） */
+    bool IsSet() const { return Index != INDEX_NONE; }
+
+    void Reset() { *this = FAuraEnemyHandle(); }
+
+    bool operator==(const FAuraEnemyHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+    bool operator!=(const FAuraEnemyHandle& Other) const { return !(*this == Other); }
+
+    friend uint32 GetTypeHash(const FAuraEnemyHandle& Handle) { return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation)); }
+};
+
+/**
+ * 敌人注册表（世界子系统）
+ * 记录当前世界中所有存活的、实现了IEnemyInterface的Actor
+ *
+ * 功能说明：
+ * 1. 敌人在BeginPlay时注册，在EndPlay时注销
+ * 2. 屏幕空间拾取等系统通过注册表遍历敌人，而不需要每帧用TActorIterator遍历整个世界
+ * 3. 每个注册的敌人占用一个槽位，外部通过FAuraEnemyHandle引用敌人：
+ *    - Resolve(Handle)是O(1)的数组访问，不需要Cast<IEnemyInterface>
+ *    - 敌人注销后句柄自动失效，不会出现悬空指针
+ *    - 空闲槽位通过空闲列表复用，注册/注销不产生额外分配
+ *
+ * 生命周期：
+ * UWorldSubsystem随World一起创建和销毁，每个World（包括PIE的每个实例）各有一份
+ */
+UCLASS()
+class AURA_API UAuraEnemyRegistry : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 注册一个敌人
+     * 接口转换只在这里执行一次，结果保存在槽位中
+     * @param Enemy 实现了IEnemyInterface的Actor，重复注册返回已有的句柄
+     * @return 敌人句柄，Actor没有实现IEnemyInterface时返回空句柄
+     */
+    FAuraEnemyHandle RegisterEnemy(AActor* Enemy);
+
+    /**
+     * 注销一个敌人
+     * 槽位代数加一，指向该敌人的所有句柄随即失效
+     * @param Enemy 之前注册过的Actor
+     */
+    void UnregisterEnemy(AActor* Enemy);
+
+    /**
+     * 查找Actor对应的句柄
+     * @return Actor不是已注册的敌人时返回空句柄
+     */
+    FAuraEnemyHandle FindHandle(const AActor* Actor) const;
+
+    /**
+     * 解析句柄得到敌人接口
+     * @return 句柄为空、已失效或敌人已被销毁时返回nullptr
+     */
+    IEnemyInterface* Resolve(const FAuraEnemyHandle& Handle) const;
+
+    /**
+     * 解析句柄得到敌人Actor
+     * @return 句柄为空、已失效或敌人已被销毁时返回nullptr
+     */
+    AActor* GetActor(const FAuraEnemyHandle& Handle) const;
+
+    /**
+     * 获取所有已注册的敌人
+     * 返回弱指针数组，调用者需要检查指针是否仍然有效
+     */
+    const TArray<TWeakObjectPtr<AActor>>& GetEnemies() const { return Enemies; }
+
+private:
+    /** 一个敌人槽位 */
+    struct FSlot
+    {
+        /** 占用该槽位的敌人，空闲时为空 */
+        TWeakObjectPtr<AActor> Actor;
+
+        /** 注册时转换好的接口指针，只在Actor有效时使用 */
+        IEnemyInterface* Enemy = nullptr;
+
+        /** 槽位代数，每次注销加一 */
+        uint32 Generation = 1;
+    };
+
+    /** 返回句柄对应的槽位，句柄无效时返回nullptr */
+    const FSlot* FindSlot(const FAuraEnemyHandle& Handle) const;
+
+    /** 已注册的敌人列表（无序，注销时使用RemoveSwap），供需要遍历所有敌人的系统使用 */
+    TArray<TWeakObjectPtr<AActor>> Enemies;
+
+    /** 所有槽位，索引即句柄的Index */
+    TArray<FSlot> Slots;
+
+    /** 空闲槽位索引 */
+    TArray<int32> FreeSlots;
+
+    /** Actor到句柄的映射，用于把检测结果中的Actor转换为句柄 */
+    TMap<TObjectKey<AActor>, FAuraEnemyHandle> HandleByActor;
+};
@@ -0,0 +1,127 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Aura/Aura.h"
+#include "AuraHighlightCategory.generated.h"
+
+/**
+ * 高亮类别
+ * 所有类别共用一个Custom Depth通道（r.CustomDepth=3启用了模板缓冲），
+ * 后期材质根据模板值区分类别并使用对应的颜色，不需要为每种类别增加额外的渲染通道
+ */
+UENUM(BlueprintType)
+enum class EAuraHighlightCategory : uint8
+{
+    /** 敌人（红色） */
+    Enemy,
+
+    /** 友方单位（蓝色） */
+    Ally,
+
+    /** 可拾取物品（金色） */
+    Pickup,
+
+    /** 任务目标（绿色） */
+    Quest,
+
+    MAX UMETA(Hidden)
+};
+
+/**
+ * 高亮后端
+ * 决定高亮请求最终如何作用到网格组件上
+ */
+UENUM(BlueprintType)
+enum class EAuraHighlightBackend : uint8
+{
+    /**
+     * Custom Depth + 模板值，由后期材质绘制轮廓
+     * 高亮的网格会额外绘制一次Custom Depth，后期材质的开销是全屏的
+     */
+    CustomDepth,
+
+    /**
+     * 叠加材质（UMeshComponent::SetOverlayMaterial）
+     * 只在被高亮的网格上多绘制一次，没有全屏开销；每个类别共享一个材质实例
+     */
+    OverlayMaterial
+};
+
+/**
+ * 一个高亮类别的渲染参数
+ * 字段全部是编译期常量，表格在编译期完成校验
+ */
+struct FAuraHighlightCategoryInfo
+{
+    /** 对应的类别，必须与表格中的位置一致 */
+    EAuraHighlightCategory Category;
+
+    /** Custom Depth模板值，后期材质据此识别类别 */
+    uint8 StencilValue;
+
+    /** 后期材质中的轮廓颜色（sRGB） */
+    uint8 R;
+    uint8 G;
+    uint8 B;
+
+    /** 材质参数集中颜色参数的名称 */
+    const TCHAR* ColorParameterName;
+};
+
+namespace AuraHighlight
+{
+    /**
+     * 高亮类别表
+     * 新增类别时：在EAuraHighlightCategory中添加枚举值，在这里按相同顺序添加一行，
+     * 并在后期材质中增加对应模板值的分支
+     */
+    inline constexpr FAuraHighlightCategoryInfo Categories[] =
+    {
+        { EAuraHighlightCategory::Enemy,  CUSTOM_DEPTH_RED, 255,  40,  40, TEXT("HighlightColor_Enemy")  },
+        { EAuraHighlightCategory::Ally,   251,               60, 140, 255, TEXT("HighlightColor_Ally")   },
+        { EAuraHighlightCategory::Pickup, 252,              255, 200,  40, TEXT("HighlightColor_Pickup") },
+        { EAuraHighlightCategory::Quest,  253,               60, 230,  90, TEXT("HighlightColor_Quest")  },
+    };
+
+    inline constexpr int32 NumCategories = UE_ARRAY_COUNT(Categories);
+
+    /** 校验表格：每个类别一行、顺序与枚举一致、模板值互不相同 */
+    constexpr bool IsCategoryTableValid()
+    {
+        if (NumCategories != static_cast<int32>(EAuraHighlightCategory::MAX)) return false;
+
+        for (int32 Index = 0; Index < NumCategories; ++Index)
+        {
+            if (static_cast<int32>(Categories[Index].Category) != Index) return false;
+
+            for (int32 OtherIndex = Index + 1; OtherIndex < NumCategories; ++OtherIndex)
+            {
+                if (Categories[Index].StencilValue == Categories[OtherIndex].StencilValue) return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(IsCategoryTableValid(), "Highlight category table must match EAuraHighlightCategory and use unique stencil values");
+
+    /** 获取类别的渲染参数 */
+    constexpr const FAuraHighlightCategoryInfo& GetCategoryInfo(EAuraHighlightCategory Category)
+    {
+        return Categories[static_cast<int32>(Category)];
+    }
+
+    /** 获取类别的模板值 */
+    constexpr int32 GetStencilValue(EAuraHighlightCategory Category)
+    {
+        return GetCategoryInfo(Category).StencilValue;
+    }
+
+    /** 获取类别的轮廓颜色（线性空间，可直接写入材质参数） */
+    inline FLinearColor GetColor(EAuraHighlightCategory Category)
+    {
+        const FAuraHighlightCategoryInfo& Info = GetCategoryInfo(Category);
+        return FLinearColor(FColor(Info.R, Info.G, Info.B));
+    }
+}
@@ -0,0 +1,114 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Interaction/AuraHighlightCategory.h"
+#include "AuraHighlightSubsystem.generated.h"
+
+class UPrimitiveComponent;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UMaterialParameterCollection;
+
+/**
+ * 高亮管理器（可Tick的世界子系统）
+ * 收集一帧内所有的高亮请求，在帧末统一应用到组件上
+ *
+ * 功能说明：
+ * 1. 同一组件在一帧内的多次请求只保留最后一次（例如光标扫过一群敌人时的高亮/取消高亮）
+ * 2. 互相抵消的请求（高亮后又取消高亮）最终状态与当前状态相同，不会产生任何渲染状态更新
+ * 3. 每个组件每帧最多更新一次渲染状态
+ * 4. 使用"stat AuraHighlight"查看请求数、实际更新数和避免的更新数
+ * 5. 两种高亮后端（见EAuraHighlightBackend），由项目设置UAuraDeveloperSettings::HighlightBackend选择
+ *
+ * 执行时机：
+ * 可Tick的世界子系统在所有Actor的Tick（包括PlayerTick中的光标检测）之后执行，
+ * 渲染状态在同一帧末尾提交，因此高亮没有额外的一帧延迟
+ */
+UCLASS()
+class AURA_API UAuraHighlightSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 子系统初始化
+     * 从项目设置读取高亮后端，叠加材质后端在这里加载基础材质
+     */
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    /**
+     * 请求设置一个组件的高亮状态，在帧末生效
+     * @param Component 需要高亮的图元组件（网格、武器等）
+     * @param bHighlighted true：按类别高亮；false：取消高亮
+     * @param Category 高亮类别，决定模板值或叠加材质的颜色，取消高亮时忽略
+     */
+    void RequestHighlight(UPrimitiveComponent* Component, bool bHighlighted, EAuraHighlightCategory Category = EAuraHighlightCategory::Enemy);
+
+    /**
+     * 把高亮类别表中的颜色写入材质参数集
+     * 后期材质按模板值从参数集中读取各类别的颜色（参数名见FAuraHighlightCategoryInfo::ColorParameterName）
+     * 关卡开始时调用一次即可
+     * @param Collection 后期材质使用的材质参数集
+     */
+    UFUNCTION(BlueprintCallable, Category = "Highlight")
+    void ApplyHighlightPalette(UMaterialParameterCollection* Collection) const;
+
+    /**
+     * 立即应用所有挂起的请求
+     * 通常不需要手动调用，Tick中会自动执行
+     */
+    void FlushHighlights();
+
+    /** 当前使用的高亮后端 */
+    EAuraHighlightBackend GetHighlightBackend() const { return Backend; }
+
+    /**
+     * 切换高亮后端（基准测试使用）
+     * 切换前应先取消所有高亮，已经按旧后端高亮的组件不会被转换
+     * @param OverlayBaseMaterial 叠加材质后端的基础材质，为空时使用项目设置中的材质
+     * @return 叠加材质后端没有可用的基础材质时返回false，后端保持不变
+     */
+    bool SetHighlightBackend(EAuraHighlightBackend NewBackend, UMaterialInterface* OverlayBaseMaterial = nullptr);
+
+    // UTickableWorldSubsystem
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+private:
+    /** 一个组件在本帧的最终高亮请求 */
+    struct FPendingHighlight
+    {
+        TWeakObjectPtr<UPrimitiveComponent> Component;
+        bool bHighlighted = false;
+        EAuraHighlightCategory Category = EAuraHighlightCategory::Enemy;
+    };
+
+    /** Custom Depth后端：写入模板值并开关Custom Depth，返回是否产生了更新 */
+    static bool ApplyCustomDepth(UPrimitiveComponent* Component, const FPendingHighlight& Pending);
+
+    /** 叠加材质后端：设置或清除叠加材质，返回是否产生了更新 */
+    bool ApplyOverlayMaterial(UPrimitiveComponent* Component, const FPendingHighlight& Pending);
+
+    /** 以基础材质为父材质，为每个类别创建一个共享的动态材质实例 */
+    void CreateOverlayMaterials(UMaterialInterface* BaseMaterial);
+
+    /** 当前使用的高亮后端 */
+    EAuraHighlightBackend Backend = EAuraHighlightBackend::CustomDepth;
+
+    /**
+     * 每个高亮类别一个叠加材质实例，按类别索引
+     * 所有敌人共享这些实例，高亮不会为单个敌人创建材质
+     */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UMaterialInstanceDynamic>> OverlayMaterials;
+
+    /** 本帧挂起的请求，按组件去重 */
+    TMap<TObjectKey<UPrimitiveComponent>, FPendingHighlight> PendingHighlights;
+
+    /** 本帧收到的请求数 */
+    uint32 NumRequestsThisFrame = 0;
+};
@@ -0,0 +1,84 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 屏幕空间拾取器
+ * 不经过物理系统（Chaos）的敌人拾取后端
+ *
+ * 工作流程：
+ * 1. Rebuild: 每帧把所有敌人根组件的包围盒投影到屏幕空间，得到屏幕矩形和深度
+ * 2. 将矩形写入一个均匀网格（每个格子CellSize像素），一个矩形可以覆盖多个格子
+ * 3. Pick: 找到光标所在的格子，只测试该格子中的矩形，返回深度最小（离摄像机最近）的Actor
+ *
+ * 性能特点：
+ * - 投影只需要一次矩阵乘法，不需要遍历物理场景或物理资产
+ * - 网格使用CSR（压缩行）布局：CellStart + CellEntries两个连续数组，重建时不产生零散分配
+ * - 查询开销只与光标所在格子中的矩形数量有关
+ *
+ * 注意：这是一个普通的C++类（不是UObject），由AAuraPlayerController按值持有
+ */
+class AURA_API FAuraScreenSpacePicker
+{
+public:
+    /**
+     * 重建屏幕空间网格
+     * @param ViewProjection 本地玩家当前的视图投影矩阵
+     * @param ViewRect 视图在视口中的像素矩形（与光标坐标处于同一坐标系）
+     * @param Candidates 候选Actor（通常来自UAuraEnemyRegistry），失效或隐藏的Actor会被跳过
+     */
+    void Rebuild(const FMatrix& ViewProjection, const FIntRect& ViewRect, TConstArrayView<TWeakObjectPtr<AActor>> Candidates);
+
+    /**
+     * 拾取光标下的Actor
+     * @param ScreenPosition 光标在视口中的像素坐标
+     * @return 屏幕矩形包含光标且离摄像机最近的Actor，没有时返回nullptr
+     */
+    AActor* Pick(const FVector2D& ScreenPosition) const;
+
+    /** 最近一次重建时投影到屏幕上的Actor数量 */
+    int32 GetNumEntries() const { return Entries.Num(); }
+
+    /** 网格格子的边长（像素） */
+    static constexpr float CellSize = 64.f;
+
+private:
+    /** 一个投影到屏幕上的Actor */
+    struct FEntry
+    {
+        /** 屏幕空间矩形（像素） */
+        FBox2D Rect;
+
+        /** 包围盒中心的视图空间深度，越小越靠近摄像机 */
+        float Depth = 0.f;
+
+        /** 对应的Actor */
+        TWeakObjectPtr<AActor> Actor;
+    };
+
+    /**
+     * 计算屏幕坐标所在的格子索引
+     * @return 坐标在视图外时返回INDEX_NONE
+     */
+    int32 GetCellIndex(const FVector2D& ScreenPosition) const;
+
+    /** 本帧投影到屏幕上的所有Actor */
+    TArray<FEntry> Entries;
+
+    /** 每个格子在CellEntries中的起始位置，长度为格子数 + 1 */
+    TArray<int32> CellStart;
+
+    /** 所有格子的Entry索引，按格子连续存放 */
+    TArray<int32> CellEntries;
+
+    /** 填充CellEntries时每个格子的写入位置（重建时复用，避免每帧分配） */
+    TArray<int32> CellWriteCursor;
+
+    /** 视图矩形（像素） */
+    FIntRect GridViewRect;
+
+    /** 网格的列数和行数 */
+    FIntPoint GridSize = FIntPoint::ZeroValue;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Interface.h"
+#include "Interaction/HighlightInterface.h"
 
 #include "EnemyInterface.generated.h"
 
@@ -22,7 +23,7 @@
  * 2. IEnemyInterface（下面定义的类）：实际的功能接口，包含纯虚函数定义
  */
 UINTERFACE(MinimalAPI, BlueprintType)  // 添加BlueprintType以支持在蓝图中使用该接口
-class UEnemyInterface : public UInterface
+class UEnemyInterface : public UHighlightInterface
 {
     // 自动生成反射和序列化所需的代码体
     // 这个宏必须放在UINTERFACE类定义的顶部
@@ -45,7 +46,7 @@ class UEnemyInterface : public UInterface
  * 3. UI系统显示敌人信息
  * 4. AI系统识别敌人状态
  */
-class AURA_API IEnemyInterface
+class AURA_API IEnemyInterface : public IHighlightInterface
 {
     // 自动生成反射和序列化所需的代码体
     // 这个宏必须放在IEnemyInterface类定义的顶部
@@ -54,50 +55,26 @@ class AURA_API IEnemyInterface
 
 public:
     /**
-     * 高亮敌人角色的纯虚函数
-     * = 0 表示这是纯虚函数，必须在继承的子类中实现
-     *
-     * 功能说明：
-     * 当敌人被玩家选中或鼠标悬停时调用此函数
-     * 通常用于视觉反馈，例如：
-     * - 显示敌人轮廓高亮
-     * - 增加材质发光效果
-     * - 播放高亮动画
-     * - 显示敌人信息UI
+     * 高亮与取消高亮（HighlightActor/UnHighlightActor）继承自IHighlightInterface
      *
      * 调用时机：
      * 1. 玩家将鼠标悬停在敌人身上（CursorTrace函数检测到）
-     * 2. 玩家通过技能或UI选择敌人
-     * 3. 游戏剧情需要强调某个敌人时
+     * 2. 玩家通过技能或UI选择敌人（范围选敌）
+     * 3. 鼠标从敌人身上移开、敌人死亡或被消灭时取消高亮
      *
-     * @注意：这个函数通常应该在客户端调用，因为视觉效果只在本地需要
+     * @注意：这两个函数通常应该在客户端调用，因为视觉效果只在本地需要
      */
-    virtual void HighlightActor() = 0;
 
     /**
-     * 取消高亮敌人角色的纯虚函数
-     * = 0 表示这是纯虚函数，必须在继承的子类中实现
-     *
-     * 功能说明：
-     * 当敌人不再被选中或鼠标移开时调用此函数
-     * 用于撤销高亮效果，恢复敌人正常外观
-     *
-     * 调用时机：
-     * 1. 鼠标从敌人身上移开
-     * 2. 玩家取消选择敌人
-     * 3. 敌人死亡或被消灭
-     *
-     * 实现注意事项：
-     * - 应该完全撤销HighlightActor所做的所有修改
-     * - 需要确保多次调用不会产生错误
-     * - 应该处理敌人被销毁时的边缘情况
+     * 敌人默认使用Enemy类别（红色轮廓）
+     * 特殊敌人（例如被魅惑后成为友方）可以重写该函数返回其他类别
      */
-    virtual void UnHighlightActor() = 0;
+    virtual EAuraHighlightCategory GetHighlightCategory() const override { return EAuraHighlightCategory::Enemy; }
 
 };  
 
 // 注意：实现这个接口的类需要：
 // 1. 在类声明中添加：public IEnemyInterface
-// 2. 实现HighlightActor()和UnHighlightActor()函数
+// 2. 实现HighlightActor()和UnHighlightActor()函数（定义在IHighlightInterface中）
 // 3. 在UCLASS宏中添加：Blueprintable（如果需要在蓝图中实现）
 // 4. 在UPROPERTY中可能需要添加Replicated标记，如果需要在网络游戏中同步高亮状态
\ No newline at end of file
@@ -0,0 +1,47 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "Interaction/AuraHighlightCategory.h"
+
+#include "HighlightInterface.generated.h"
+
+/**
+ * 反射接口类（UHighlightInterface）
+ * 用于Unreal Engine的反射和蓝图系统，实际功能在下面的IHighlightInterface中定义
+ */
+UINTERFACE(MinimalAPI, BlueprintType)
+class UHighlightInterface : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * 可高亮接口（IHighlightInterface）
+ * 所有可以被光标或技能高亮的对象的公共接口：敌人、友方单位、可拾取物品、任务目标等
+ *
+ * 不同类别通过GetHighlightCategory返回各自的模板值和颜色，
+ * 共用同一个Custom Depth通道和同一个后期材质
+ */
+class AURA_API IHighlightInterface
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 高亮对象
+     * 实现时应使用GetHighlightCategory对应的模板值（AuraHighlight::GetStencilValue）
+     */
+    virtual void HighlightActor() = 0;
+
+    /**
+     * 取消高亮，完全撤销HighlightActor所做的修改
+     * 需要确保多次调用不会产生错误
+     */
+    virtual void UnHighlightActor() = 0;
+
+    /** 对象的高亮类别，决定模板值和轮廓颜色 */
+    virtual EAuraHighlightCategory GetHighlightCategory() const = 0;
+};
@@ -0,0 +1,148 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "WorldCollision.h"
+#include "AuraCursorHitSubsystem.generated.h"
+
+/**
+ * 光标命中服务（本地玩家子系统）
+ * 每个本地玩家一份，统一负责光标下的射线检测，并把结果共享给所有使用者
+ *
+ * 功能说明：
+ * 1. 每帧每个碰撞通道最多检测一次，无论有多少系统读取（悬停高亮、范围选敌、点击移动、提示框等）
+ * 2. 同步/异步两种检测方式（aura.CursorTrace.Async）
+ * 3. 悬停缓存：光标位置、视图投影矩阵、上次命中的Actor都未变化时跳过检测（aura.CursorTrace.Cache）
+ * 4. 每帧的光标视图数据（屏幕坐标、视图投影矩阵、光标射线）也只计算一次
+ *
+ * 使用方式：
+ * UAuraCursorHitSubsystem* CursorHitSubsystem = ULocalPlayer::GetSubsystem<UAuraCursorHitSubsystem>(LocalPlayer);
+ * const FHitResult& Hit = CursorHitSubsystem->GetCursorHit(ECC_Visibility);
+ *
+ * 注意：返回的引用在下一次同一通道检测更新前有效，不要跨帧保存
+ */
+UCLASS()
+class AURA_API UAuraCursorHitSubsystem : public ULocalPlayerSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * 子系统初始化
+     * 绑定异步检测完成委托
+     */
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+    /**
+     * 获取本帧指定通道的光标命中结果
+     * 本帧第一次读取某个通道时才会检测（或命中缓存直接跳过），之后的读取直接返回缓存结果
+     * 异步模式下返回的是上一帧提交的检测结果
+     * @param TraceChannel 检测通道，例如ECC_Target（选中目标）、ECC_Visibility（地面）
+     * @return 命中结果，未命中时bBlockingHit为false
+     */
+    const FHitResult& GetCursorHit(ECollisionChannel TraceChannel);
+
+    /**
+     * 获取本帧的光标射线（世界空间）
+     * @return 光标不在视口内时返回false
+     */
+    bool GetCursorRay(FVector& OutOrigin, FVector& OutDirection);
+
+    /**
+     * 获取本帧的光标视图数据
+     * @param OutCursorPosition 光标在视口中的像素坐标
+     * @param OutViewProjection 当前视图投影矩阵
+     * @param OutViewRect 视图在视口中的像素矩形
+     * @return 光标不在视口内或无法获取投影数据时返回false
+     */
+    bool GetCursorView(FVector2D& OutCursorPosition, FMatrix& OutViewProjection, FIntRect& OutViewRect);
+
+    /**
+     * 设置光标坐标覆盖（输入回放使用）
+     * 设置后不再读取真实鼠标位置，从下一次计算光标视图数据开始生效
+     * @param CursorPosition 光标像素坐标，为空时光标视为不在视口内
+     */
+    void SetCursorPositionOverride(const TOptional<FVector2D>& CursorPosition);
+
+    /** 清除光标坐标覆盖，恢复读取真实鼠标位置 */
+    void ClearCursorPositionOverride();
+
+private:
+    /** 每帧计算一次的光标视图数据 */
+    struct FCursorView
+    {
+        /** 计算该数据时的帧号 */
+        uint64 FrameNumber = MAX_uint64;
+
+        /** 光标是否在视口内且投影数据有效 */
+        bool bValid = false;
+
+        FVector2D CursorPosition = FVector2D::ZeroVector;
+        FMatrix ViewProjection = FMatrix::Identity;
+        FIntRect ViewRect;
+        FVector RayOrigin = FVector::ZeroVector;
+        FVector RayDirection = FVector::ZeroVector;
+    };
+
+    /** 单个碰撞通道的检测状态与悬停缓存 */
+    struct FChannelState
+    {
+        /** 最近一次更新该通道的帧号，同一帧内的重复读取直接返回Hit */
+        uint64 FrameNumber = MAX_uint64;
+
+        /** 最近一次检测结果 */
+        FHitResult Hit;
+
+        /** 等待结果的异步检测句柄 */
+        FTraceHandle PendingTrace;
+
+        /** 悬停缓存键：最近一次发起检测时的光标坐标、视图投影矩阵和时间 */
+        bool bCacheValid = false;
+        FVector2D CachedCursorPosition = FVector2D::ZeroVector;
+        FMatrix CachedViewProjection = FMatrix::Identity;
+        double CachedTraceTime = 0.0;
+
+        /** 最近一次命中的Actor及其当时的变换，移动或销毁时视为"世界变脏" */
+        TWeakObjectPtr<AActor> CachedHitActor;
+        FTransform CachedHitActorTransform;
+    };
+
+    /** 计算（每帧一次）并返回本帧的光标视图数据 */
+    const FCursorView& UpdateCursorView();
+
+    /** 判断某个通道本帧是否可以跳过检测 */
+    bool CanSkipTrace(const FChannelState& State, const FCursorView& View) const;
+
+    /** 写入一个通道的检测结果，并记录"世界变脏"判断所需的命中Actor变换 */
+    static void SetChannelHit(FChannelState& State, const FHitResult& Hit);
+
+    /** 异步检测完成回调，按FTraceDatum::TraceChannel分发到对应通道 */
+    void OnAsyncTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+    /** 记录一次检测（发起或跳过），并周期性地更新跳过比例统计 */
+    void RecordTraceStat(bool bSkipped);
+
+    /** 本帧的光标视图数据 */
+    FCursorView CursorView;
+
+    /** 是否使用光标坐标覆盖 */
+    bool bOverrideCursorPosition = false;
+
+    /** 光标坐标覆盖值，为空表示光标不在视口内 */
+    TOptional<FVector2D> CursorPositionOverride;
+
+    /**
+     * 每个碰撞通道一份状态，按通道值直接索引
+     * 使用定长数组保证元素地址稳定，GetCursorHit返回的引用不会因为新增通道而失效
+     */
+    TStaticArray<FChannelState, ECC_MAX> Channels;
+
+    /** 异步检测完成委托，所有通道共用 */
+    FTraceDelegate AsyncTraceDelegate;
+
+    /** 当前统计窗口内发起和跳过的检测次数 */
+    uint32 TracesIssuedInWindow = 0;
+    uint32 TracesSkippedInWindow = 0;
+};
@@ -0,0 +1,136 @@
+// Copyright Amor
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 一帧录制的输入
+ * 移动输入是Move在该帧累加后的合并值（与ApplyPendingMoveInput提交的值相同）
+ */
+struct FAuraRecordedInputFrame
+{
+    /** 距离录制开始的时间（秒） */
+    float Time = 0.f;
+
+    /** 该帧是否有移动输入 */
+    bool bHasMoveInput = false;
+
+    /** 该帧的光标坐标是否有效（光标在视口内） */
+    bool bHasCursorPosition = false;
+
+    /** 该帧是否触发了点击移动（ClickMoveAction） */
+    bool bClickMove = false;
+
+    /** 该帧累加的MoveAction输入值 */
+    FVector2f MoveInput = FVector2f::ZeroVector;
+
+    /** 光标在视口中的像素坐标 */
+    FVector2f CursorPosition = FVector2f::ZeroVector;
+};
+
+/**
+ * 输入录制与回放
+ * 用于性能测试：在同一张地图上重复完全相同的操作，比较不同版本的帧时间
+ *
+ * 工作流程：
+ * 1. 录制：每帧记录一条FAuraRecordedInputFrame（移动输入、点击移动、光标坐标、时间戳）
+ * 2. 停止录制时写入紧凑的二进制文件（Saved/Profiling/InputRecordings/<Name>.airec）
+ * 3. 回放：每帧取出一条记录，代替真实输入驱动Move、点击移动和CursorTrace
+ *
+ * 回放按帧推进而不是按时间推进：无论回放时帧率如何，每一帧看到的输入都与录制时相同
+ * 回放期间引擎使用固定时间步长（录制时的平均帧时间），每帧的DeltaTime与录制时一致，
+ * 同一输入在不同版本中产生相同的移动路径；回放结束或中止后恢复原来的时间步长设置
+ *
+ * 文件格式：
+ * Magic(uint32) Version(uint32) NumFrames(int32)，之后每帧：
+ * Time(float) Flags(uint8) [MoveInput(2*float)] [CursorPosition(2*float)]
+ * 没有移动输入或光标无效的帧省略对应字段，点击移动只占Flags中的一位
+ *
+ * 注意：这是一个普通的C++类（不是UObject），由AAuraPlayerController按值持有
+ */
+class AURA_API FAuraInputRecorder
+{
+public:
+    /** 持有者销毁时（例如回放中切换地图）中止回放，恢复固定时间步长设置 */
+    ~FAuraInputRecorder() { StopReplay(); }
+
+    /**
+     * 开始录制，清空之前录制的帧
+     * @param Name 录制名称，停止录制时写入对应的文件
+     */
+    void StartRecording(const FString& Name);
+
+    /**
+     * 记录一帧输入（只在录制中生效）
+     * @param MoveInput 本帧累加的移动输入，没有移动输入时为空
+     * @param CursorPosition 本帧光标坐标，光标不在视口内时为空
+     * @param bClickMove 本帧是否触发了点击移动
+     */
+    void RecordFrame(const TOptional<FVector2D>& MoveInput, const TOptional<FVector2D>& CursorPosition, bool bClickMove);
+
+    /**
+     * 停止录制并写入文件
+     * @return 文件写入成功时返回true
+     */
+    bool StopRecording();
+
+    /**
+     * 读取录制文件并开始回放
+     * @return 文件不存在或格式不正确时返回false
+     */
+    bool StartReplay(const FString& Name);
+
+    /**
+     * 取出下一帧回放输入
+     * @return 回放结束时返回nullptr，并输出录制与回放的耗时对比
+     */
+    const FAuraRecordedInputFrame* NextReplayFrame();
+
+    /** 中止回放 */
+    void StopReplay();
+
+    bool IsRecording() const { return Mode == EMode::Recording; }
+    bool IsReplaying() const { return Mode == EMode::Replaying; }
+
+    /** 录制名称对应的文件路径 */
+    static FString GetRecordingFilePath(const FString& Name);
+
+private:
+    enum class EMode : uint8
+    {
+        Idle,
+        Recording,
+        Replaying
+    };
+
+    /** 写入/读取帧数组 */
+    static void SerializeFrames(FArchive& Ar, TArray<FAuraRecordedInputFrame>& InOutFrames);
+
+    /** 输出回放结果（帧数、录制耗时、回放耗时、平均帧时间） */
+    void LogReplaySummary() const;
+
+    /** 录制时的平均帧时间（秒），回放时作为固定时间步长 */
+    double GetRecordedDeltaTime() const;
+
+    /** 恢复回放开始前的固定时间步长设置 */
+    void RestoreTimeStep();
+
+    EMode Mode = EMode::Idle;
+
+    /** 当前录制或回放的名称 */
+    FString RecordingName;
+
+    /** 录制或回放开始的时间（FPlatformTime::Seconds） */
+    double StartTime = 0.0;
+
+    /** 录制的所有帧 */
+    TArray<FAuraRecordedInputFrame> Frames;
+
+    /** 下一条要回放的帧 */
+    int32 ReplayIndex = 0;
+
+    /** 回放开始前的固定时间步长设置，回放结束后恢复 */
+    bool bPreviousUseFixedTimeStep = false;
+    double PreviousFixedDeltaTime = 1.0 / 30.0;
+};
@@ -4,7 +4,12 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/PlayerController.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Engine/OverlapResult.h"
 #include "Interaction/EnemyInterface.h"
+#include "Interaction/AuraEnemyRegistry.h"
+#include "Interaction/AuraScreenSpacePicker.h"
+#include "Player/AuraInputRecorder.h"
 
 #include "AuraPlayerController.generated.h"
 
@@ -13,7 +18,22 @@
 class UInputMappingContext;   // 输入映射上下文类的前向声明，用于定义输入绑定
 class UInputAction;           // 输入动作类的前向声明，表示单个输入操作
 struct FInputActionValue;     // 输入动作值结构体的前向声明，包含输入数据
+class UAuraCursorHitSubsystem; // 光标命中服务，每个本地玩家一份，共享每帧的光标检测结果
+class USplineComponent;       // 样条组件，缓存点击移动的寻路路径
 
+/**
+ * 光标拾取后端
+ * 决定CursorTrace如何找到光标下的敌人
+ */
+UENUM(BlueprintType)
+enum class EAuraCursorPickingMode : uint8
+{
+    /** 物理射线检测：沿光标射线检测ECC_Target通道（同步或异步，见aura.CursorTrace.Async） */
+    Physics,
+
+    /** 屏幕空间拾取：把所有敌人的包围盒投影到屏幕网格中查询，不经过物理系统 */
+    ScreenSpace
+};
 
 
 /**
@@ -46,6 +66,58 @@ public:
      */
     virtual void PlayerTick(float DeltaTime) override;
 
+    /**
+     * 开始范围选敌预览
+     * 之后每帧以光标位置为中心进行一次球形重叠查询，高亮半径内的所有敌人
+     * 用于范围技能的施法预览
+     * @param Radius 选敌半径（厘米）
+     */
+    UFUNCTION(BlueprintCallable, Category = "Targeting")
+    void BeginAreaTargeting(float Radius);
+
+    /**
+     * 结束范围选敌预览，取消所有范围目标的高亮
+     */
+    UFUNCTION(BlueprintCallable, Category = "Targeting")
+    void EndAreaTargeting();
+
+    /**
+     * 获取本帧范围选敌的结果
+     * 返回紧凑的敌人句柄数组，技能释放时通过UAuraEnemyRegistry::GetActor解析，不需要再次查询
+     */
+    const TArray<FAuraEnemyHandle>& GetAreaTargets() const { return AreaTargets; }
+
+    /**
+     * 开始录制输入（控制台命令：AuraRecordInput <Name>）
+     * 每帧记录移动输入和光标坐标，停止时写入Saved/Profiling/InputRecordings/<Name>.airec
+     */
+    UFUNCTION(Exec)
+    void AuraRecordInput(const FString& Name);
+
+    /** 停止录制输入并写入文件（控制台命令：AuraStopRecordInput） */
+    UFUNCTION(Exec)
+    void AuraStopRecordInput();
+
+    /**
+     * 回放录制的输入（控制台命令：AuraReplayInput <Name>）
+     * 回放期间忽略真实的移动和点击输入，每帧按录制内容驱动Move和CursorTrace
+     * 也可以通过命令行-AuraReplayInput=<Name>在启动时开始回放，加上-AuraReplayInputExit在回放结束后退出
+     */
+    UFUNCTION(Exec)
+    void AuraReplayInput(const FString& Name);
+
+    /** 中止输入回放（控制台命令：AuraStopReplayInput） */
+    UFUNCTION(Exec)
+    void AuraStopReplayInput();
+
+    /**
+     * 获取该玩家当前的悬停目标
+     * 服务器：客户端上报并经过校验的目标，供服务器端技能使用
+     * 本地客户端：本地光标检测到的目标
+     * @return 没有目标或目标已销毁时返回nullptr
+     */
+    AActor* GetHoverTarget() const;
+
 protected:
     /**
      * 游戏开始时调用
@@ -90,6 +162,113 @@ private:
      */
     void Move(const FInputActionValue& InputActionValue);
 
+    /**
+     * 把本帧累加的移动输入合并为一次AddMovementInput，在PlayerTick中调用
+     * 摄像机偏航基向量每帧只计算一次
+     */
+    void ApplyPendingMoveInput();
+
+    /** 本帧累加的移动输入（Move只写入这里，不直接驱动Pawn） */
+    FVector2D PendingMoveInput = FVector2D::ZeroVector;
+
+    /** 本帧是否收到过移动输入 */
+    bool bHasPendingMoveInput = false;
+
+    /** 输入录制与回放 */
+    FAuraInputRecorder InputRecorder;
+
+    /** 回放结束后是否退出游戏（命令行-AuraReplayInputExit） */
+    bool bExitAfterInputReplay = false;
+
+    /**
+     * 回放：在处理真实输入之前注入本帧录制的光标坐标和移动输入
+     * 回放结束时恢复真实光标
+     */
+    void UpdateInputReplay();
+
+    /** 录制：在输入处理完成后记录本帧累加的移动输入、点击移动和光标坐标 */
+    void RecordInputFrame();
+
+    /**
+     * 点击移动输入动作（通常绑定鼠标左键）
+     * 按住时目的地跟随光标，松开后继续沿路径走到最后的目的地
+     */
+    UPROPERTY(EditAnywhere, Category = "Input")
+    TObjectPtr<UInputAction> ClickMoveAction;
+
+    /**
+     * 点击移动处理函数，按下和按住期间每帧调用
+     * 输入回调在CursorTrace之前执行，这里只记录本帧有点击，目的地由ResolveClickMove确定
+     */
+    void ClickMove(const FInputActionValue& InputActionValue);
+
+    /**
+     * 确定点击移动的目的地，在PlayerTick中CursorTrace之后调用
+     * 复用本帧CursorTrace的ECC_Target命中点（地面同样阻挡该通道），不会额外发射射线；
+     * 没有命中时用光标射线与角色脚下水平面的交点
+     */
+    void ResolveClickMove();
+
+    /** 本帧是否收到过点击移动输入（回放时来自录制文件） */
+    bool bClickMoveRequested = false;
+
+    /**
+     * 设置点击移动的目的地
+     * 与当前目的地距离小于RepathDistanceThreshold时直接返回，继续沿已缓存的路径移动
+     * 否则取消未完成的寻路请求并发起新的异步寻路
+     */
+    void SetMoveDestination(const FVector& Destination);
+
+    /**
+     * 异步寻路完成回调，在游戏线程上执行
+     * 把路径点写入Spline并开始自动移动
+     */
+    void OnMovePathFound(uint32 QueryId, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path);
+
+    /**
+     * 沿缓存的Spline移动，在PlayerTick中每帧调用
+     * 到达终点附近（AutoRunAcceptanceRadius以内）时停止
+     */
+    void AutoRun();
+
+    /**
+     * 停止点击移动：取消未完成的寻路请求，清除目的地
+     */
+    void StopAutoRun();
+
+    /**
+     * 点击移动的路径缓存
+     * 只在寻路完成时重建，之后每帧只做最近点查询
+     */
+    UPROPERTY(VisibleAnywhere, Category = "Movement")
+    TObjectPtr<USplineComponent> Spline;
+
+    /**
+     * 目的地移动超过该距离（厘米）时才重新寻路
+     * 按住鼠标拖动时光标每帧都在变化，阈值避免了每帧发起寻路请求
+     */
+    UPROPERTY(EditAnywhere, Category = "Movement")
+    float RepathDistanceThreshold = 100.f;
+
+    /** 距离路径终点小于该距离（厘米）时视为到达 */
+    UPROPERTY(EditAnywhere, Category = "Movement")
+    float AutoRunAcceptanceRadius = 50.f;
+
+    /** 当前点击移动的目的地（光标命中点），用于判断是否需要重新寻路 */
+    FVector MoveDestination = FVector::ZeroVector;
+
+    /** 路径的实际终点（部分路径时与MoveDestination不同） */
+    FVector PathEndLocation = FVector::ZeroVector;
+
+    /** 是否已有点击移动目的地 */
+    bool bHasMoveDestination = false;
+
+    /** 是否正在沿Spline自动移动 */
+    bool bAutoRunning = false;
+
+    /** 未完成的异步寻路请求ID，没有请求时为INVALID_NAVQUERYID */
+    uint32 PendingPathQueryId = INVALID_NAVQUERYID;
+
     /**
      * 光标准踪函数 - 用于检测光标下的交互对象
      * 通过射线检测从屏幕光标位置向游戏世界发射射线，检测命中的对象
@@ -98,17 +277,143 @@ private:
     void CursorTrace();
 
     /**
-     * 上一帧检测到的Actor接口指针
+     * 光标拾取后端
+     * Physics: 物理射线检测（默认）
+     * ScreenSpace: 屏幕空间拾取，敌人数量很多时不需要每帧经过物理系统
+     * 可使用控制台命令aura.Benchmark.CursorPicking对比两种后端的开销
+     */
+    UPROPERTY(EditAnywhere, Category = "Targeting")
+    EAuraCursorPickingMode CursorPickingMode = EAuraCursorPickingMode::Physics;
+
+    /**
+     * 屏幕空间拾取器
+     * 仅在CursorPickingMode为ScreenSpace时每帧重建
+     */
+    FAuraScreenSpacePicker ScreenSpacePicker;
+
+    /**
+     * 使用屏幕空间拾取器找到光标下的敌人，并驱动高亮状态机
+     * @param CursorPosition 光标像素坐标
+     * @param ViewProjection 当前视图投影矩阵
+     * @param ViewRect 当前视图矩形
+     */
+    void ScreenSpaceCursorTrace(const FVector2D& CursorPosition, const FMatrix& ViewProjection, const FIntRect& ViewRect);
+
+    /**
+     * 获取本地玩家的光标命中服务
+     * @return 非本地控制器（没有LocalPlayer）时返回nullptr
+     */
+    UAuraCursorHitSubsystem* GetCursorHitSubsystem() const;
+
+    /**
+     * 根据一次光标射线检测的结果驱动高亮状态机
+     * 物理检测与屏幕空间拾取最终都汇总到这里，保证高亮逻辑只有一份
+     * @param CursorHit 光标射线检测结果（未命中时bBlockingHit为false）
+     */
+    void HandleCursorHit(const FHitResult& CursorHit);
+
+    /**
+     * 本帧CursorTrace的ECC_Target结果（屏幕空间拾取时为拾取结果）
+     * 点击移动和范围选敌读取这里，不再对其他通道发起检测
+     */
+    FHitResult FrameCursorHit;
+
+    /**
+     * 光标射线与角色脚下水平面的交点（俯视角游戏中地面近似为水平面）
+     * 光标没有命中任何物体时代替地面命中点
+     * @return 没有Pawn、没有光标或射线与地平面不相交时返回false
+     */
+    bool GetCursorGroundPlanePoint(FVector& OutPoint) const;
+
+    /**
+     * 范围选敌：复用光标命中服务本帧的检测结果确定中心点，执行一次球形重叠查询，
+     * 只对与上一帧结果的差集调用高亮/取消高亮
+     */
+    void UpdateAreaTargeting();
+
+    /**
+     * 获取范围选敌的中心点
+     * 使用本帧CursorTrace的ECC_Target命中点（FrameCursorHit），
+     * 没有命中时用光标射线与角色脚下水平面的交点
+     * @return 无法确定中心点时返回false
+     */
+    bool GetAreaTargetingCenter(FVector& OutCenter) const;
+
+    /**
+     * 判断某个敌人是否在范围选敌结果中
+     * 光标离开该敌人时，如果它仍在范围内，则保持高亮
+     */
+    bool IsAreaTarget(const FAuraEnemyHandle& Enemy) const;
+
+    /** 获取当前世界的敌人注册表 */
+    UAuraEnemyRegistry* GetEnemyRegistry() const;
+
+    /** 范围选敌是否激活 */
+    bool bAreaTargetingActive = false;
+
+    /** 范围选敌半径（厘米） */
+    float AreaTargetingRadius = 0.f;
+
+    /**
+     * 上报悬停目标（客户端 -> 服务器）
+     * Unreliable: 丢包时由周期性重发补偿，不阻塞可靠通道
+     * 参数是Actor指针，网络上只序列化它的NetGUID，而不是完整的FHitResult
+     */
+    UFUNCTION(Server, Unreliable)
+    void ServerSetHoverTarget(AActor* Target);
+
+    /**
+     * 本地悬停目标变化时向服务器上报，在PlayerTick中CursorTrace之后调用
+     * 目标变化时发送，但两次发送至少间隔HoverTargetMinSendInterval
+     * 目标不变时每隔HoverTargetResendInterval重发一次，补偿不可靠RPC的丢包
+     */
+    void UpdateServerHoverTarget();
+
+    /** 两次上报悬停目标的最小间隔（秒），光标快速扫过多个敌人时合并为一次发送 */
+    UPROPERTY(EditAnywhere, Category = "Targeting")
+    float HoverTargetMinSendInterval = 0.1f;
+
+    /** 悬停目标不变时的重发间隔（秒） */
+    UPROPERTY(EditAnywhere, Category = "Targeting")
+    float HoverTargetResendInterval = 1.f;
+
+    /** 服务器接受的悬停目标与玩家角色的最大距离（厘米），超出时视为无效目标 */
+    UPROPERTY(EditAnywhere, Category = "Targeting")
+    float MaxHoverTargetDistance = 5000.f;
+
+    /** 本地光标检测到的悬停目标（与ThisActor对应的Actor） */
+    TWeakObjectPtr<AActor> LocalHoverTarget;
+
+    /** 最近一次上报给服务器的目标 */
+    TWeakObjectPtr<AActor> SentHoverTarget;
+
+    /** 最近一次上报的时间（世界时间，秒） */
+    double LastHoverTargetSendTime = -UE_BIG_NUMBER;
+
+    /** 服务器端经过校验的悬停目标 */
+    TWeakObjectPtr<AActor> ServerHoverTarget;
+
+    /** 当前范围选敌的结果（上一帧高亮的集合） */
+    TArray<FAuraEnemyHandle> AreaTargets;
+
+    /** 重叠查询的临时结果，作为成员复用以避免每帧分配 */
+    TArray<FAuraEnemyHandle> NewAreaTargets;
+
+    /** 球形重叠查询的原始结果，同样作为成员复用 */
+    TArray<FOverlapResult> AreaOverlaps;
+
+    /**
+     * 上一帧检测到的敌人句柄
      * 用于追踪前一帧光标下的交互对象，实现对象进出状态的检测
-     * IEnemyInterface* 类型表示实现了敌人接口的对象
+     * 敌人销毁或回收后句柄自动失效，解析结果为nullptr，不会访问悬空指针
      */
-    IEnemyInterface* LastActor;
+    FAuraEnemyHandle LastActor;
 
     /**
-     * 当前帧检测到的Actor接口指针
+     * 当前帧检测到的敌人句柄
      * 存储当前帧光标下检测到的交互对象
      * 通过比较LastActor和ThisActor，可以判断交互对象的变化
      */
-    IEnemyInterface* ThisActor;
+    FAuraEnemyHandle ThisActor;
 
 };  
\ No newline at end of file